@@ -0,0 +1,250 @@
+/*****************************************************************************************************************
+* Copyright (C) 2019 by Matthias Birnthaler                                                                      *
+*                                                                                                                *
+* This file is part of the Cuddle Plugin for Ark Server API                                                      *
+*                                                                                                                *
+*    This program is free software : you can redistribute it and/or modify                                       *
+*    it under the terms of the GNU General Public License as published by                                        *
+*    the Free Software Foundation, either version 3 of the License, or                                           *
+*    (at your option) any later version.                                                                         *
+*                                                                                                                *
+*    This program is distributed in the hope that it will be useful,                                             *
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of                                              *
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the                                                 *
+*    GNU General Public License for more details.                                                                *
+*                                                                                                                *
+*    You should have received a copy of the GNU General Public License                                           *
+*    along with this program.If not, see <https://www.gnu.org/licenses/>.                                        *
+*                                                                                                                *
+*****************************************************************************************************************/
+
+/**
+* \file Defaults.cpp
+* \author Matthias Birnthaler Matthias-Birnthaler@outlook.com
+* \date 18 October 2026
+* \brief Implementation of the built-in configuration of the vanilla species and foods
+*
+*/
+
+/* ================================================ [includes] ================================================ */
+#include "Defaults.h"
+
+
+namespace Defaults {
+
+    /* =============================================== [local data] =============================================== */
+
+    /** \brief Built-in dino list, sorted by the dino tag case insensitive like CompareTags */
+    static constexpr Species_t Defaults_Species[] = {
+        { "Allo",              30.0f,   1.0f },
+        { "Angler",            30.0f,   1.0f },
+        { "Anky",              30.0f,   1.0f },
+        { "Archa",             20.0f,   1.0f },
+        { "Argent",            30.0f,   1.0f },
+        { "Baryonyx",          30.0f,   1.0f },
+        { "Basilosaurus",      30.0f,  0.25f },
+        { "Beaver",            30.0f,   1.0f },
+        { "Bigfoot",           30.0f,   1.0f },
+        { "Bigly",             30.0f,   0.5f },
+        { "Bloodstalker",      30.0f,   1.0f },
+        { "Bronto",            30.0f,   0.5f },
+        { "Camelsaurus",       30.0f,   1.0f },
+        { "Carno",             30.0f,   1.0f },
+        { "CaveWolf",          30.0f,   1.0f },
+        { "Chalicotherium",    30.0f,   0.5f },
+        { "Compy",             30.0f,   1.0f },
+        { "Daeodon",           30.0f,   1.0f },
+        { "Deinonychus",       30.0f,   1.0f },
+        { "Dilo",              30.0f,   1.0f },
+        { "Dimetro",           30.0f,   1.0f },
+        { "Dimorph",           30.0f,   1.0f },
+        { "Diplo",             30.0f,   0.5f },
+        { "Diplocaulus",       30.0f,   1.0f },
+        { "Direbear",          30.0f,   1.0f },
+        { "Direwolf",          30.0f,   1.0f },
+        { "Dodo",              20.0f,   1.0f },
+        { "Doed",              30.0f,   1.0f },
+        { "Dolphin",           30.0f,   1.0f },
+        { "Dunkle",            30.0f,   0.5f },
+        { "Equus",             30.0f,   1.0f },
+        { "Gacha",             30.0f,   0.5f },
+        { "Galli",             30.0f,   1.0f },
+        { "GasBags",           30.0f,   1.0f },
+        { "GiantTurtle",       30.0f,   0.5f },
+        { "Gigant",            30.0f,  0.17f },
+        { "Gremlin",           30.0f,   0.5f },
+        { "Hesperornis",       30.0f,   1.0f },
+        { "Hyaenodon",         30.0f,   1.0f },
+        { "Ichthyornis",       30.0f,   1.0f },
+        { "Iguanodon",         30.0f,   1.0f },
+        { "Jerboa",            30.0f,   1.0f },
+        { "Kairu",             30.0f,   1.0f },
+        { "Kangaroo",          30.0f,   1.0f },
+        { "Kaprosuchus",       30.0f,   1.0f },
+        { "Kentro",            30.0f,   1.0f },
+        { "Lantern Bird",      30.0f,   1.0f },
+        { "Lantern Goat",      30.0f,   1.0f },
+        { "Lantern Lizard",    30.0f,   1.0f },
+        { "LavaLizard",        30.0f,  0.25f },
+        { "Lystro",            20.0f,   1.0f },
+        { "Mammoth",           30.0f,   1.0f },
+        { "Managarmr",         30.0f,   0.5f },
+        { "Manta",             30.0f,   1.0f },
+        { "Mega",              30.0f,   1.0f },
+        { "Megalania",         30.0f,   1.0f },
+        { "Megalosaurus",      30.0f,   0.5f },
+        { "Megatherium",       30.0f,   0.5f },
+        { "Microraptor",       30.0f,   1.0f },
+        { "MoleRat",           30.0f,   1.0f },
+        { "Monkey",            30.0f,   1.0f },
+        { "Mosasaur",          30.0f,  0.17f },
+        { "Moschops",          30.0f,   1.0f },
+        { "Otter",             20.0f,   1.0f },
+        { "Ovi",               20.0f,   1.0f },
+        { "Owl",               30.0f,   1.0f },
+        { "Pachy",             30.0f,   1.0f },
+        { "Pachyrhinosaurus",  30.0f,   1.0f },
+        { "Para",              30.0f,   1.0f },
+        { "Paracer",           30.0f,   0.5f },
+        { "Pegomastax",        30.0f,   1.0f },
+        { "Pela",              30.0f,   1.0f },
+        { "Phiomia",           30.0f,   1.0f },
+        { "Plesiosaur",        30.0f,  0.25f },
+        { "Ptera",             30.0f,   1.0f },
+        { "Pug",               30.0f,   1.0f },
+        { "Purlovia",          30.0f,   1.0f },
+        { "Quetz",             30.0f,  0.25f },
+        { "Raptor",             1.0f,   1.0f },
+        { "Rex",               30.0f,   0.5f },
+        { "Rhino",             30.0f,   1.0f },
+        { "RockDrake",         30.0f,   0.5f },
+        { "Sabertooth",        30.0f,   1.0f },
+        { "Sarco",             30.0f,   1.0f },
+        { "Sheep",             30.0f,   1.0f },
+        { "SpineyLizard",      30.0f,   1.0f },
+        { "Spino",             30.0f,   1.0f },
+        { "Stag",              30.0f,   1.0f },
+        { "Stego",             30.0f,   1.0f },
+        { "Tapejara",          30.0f,   1.0f },
+        { "TerrorBird",        30.0f,   1.0f },
+        { "Therizinosaurus",   30.0f,   0.5f },
+        { "Thylacoleo",        30.0f,   1.0f },
+        { "Toad",              30.0f,   1.0f },
+        { "Trike",             30.0f,   1.0f },
+        { "Troodon",           20.0f,   1.0f },
+        { "Tropeognathus",     30.0f,   0.5f },
+        { "Turtle",            30.0f,   1.0f },
+        { "Tusoteuthis",       30.0f,  0.17f },
+        { "Velonasaur",        30.0f,   1.0f },
+        { "Vulture",           30.0f,   1.0f },
+        { "Wyvern",            30.0f,   0.5f },
+        { "Xenomorph",         30.0f,   0.5f },
+        { "Yutyrannus",        30.0f,  0.25f }
+    };
+
+    /** \brief Built-in food list for the cuddly type food */
+    static constexpr const char* Defaults_Foods[] = {
+        "Blueprint'/Game/PrimalEarth/CoreBlueprints/Items/Consumables/PrimalItemConsumable_Kibble_Base_XSmall.PrimalItemConsumable_Kibble_Base_XSmall'",
+        "Blueprint'/Game/PrimalEarth/CoreBlueprints/Items/Consumables/PrimalItemConsumable_Kibble_Base_Special.PrimalItemConsumable_Kibble_Base_Special'",
+        "Blueprint'/Game/PrimalEarth/CoreBlueprints/Items/Consumables/PrimalItemConsumable_Kibble_Base_XLarge.PrimalItemConsumable_Kibble_Base_XLarge'",
+        "Blueprint'/Game/PrimalEarth/CoreBlueprints/Items/Consumables/PrimalItemConsumable_Kibble_Base_Medium.PrimalItemConsumable_Kibble_Base_Medium'",
+        "Blueprint'/Game/PrimalEarth/CoreBlueprints/Items/Consumables/PrimalItemConsumable_Kibble_Base_Small.PrimalItemConsumable_Kibble_Base_Small'",
+        "Blueprint'/Game/PrimalEarth/CoreBlueprints/Items/Consumables/PrimalItemConsumable_Kibble_Base_Large.PrimalItemConsumable_Kibble_Base_Large'"
+    };
+
+
+    /* ===================================== [prototype of local functions] ======================================= */
+
+    static constexpr int FoldCase(char Character);
+    static constexpr int CompareTags(const char* A, const char* B);
+    static constexpr bool IsSorted(void);
+
+
+    /**
+    * \brief FoldCase
+    *
+    * \param[in] Character the character of a dino tag
+    * \return int the character folded to lower case
+    */
+    static constexpr int FoldCase(char Character)
+    {
+        const int character = static_cast<int>(static_cast<unsigned char>(Character));
+
+        return ((character >= 'A') && (character <= 'Z')) ? (character + ('a' - 'A')) : character;
+    }
+
+
+    /**
+    * \brief CompareTags
+    *
+    * This function compares two dino tags at compile time, case insensitive like the dino tags of the game
+    *
+    * \param[in] A dino tag A
+    * \param[in] B dino tag B
+    * \return int: negative if A is ordered before B, 0 if equal, otherwise positive
+    */
+    static constexpr int CompareTags(const char* A, const char* B)
+    {
+        while (('\0' != *A) && (FoldCase(*A) == FoldCase(*B)))
+        {
+            A++;
+            B++;
+        }
+
+        return FoldCase(*A) - FoldCase(*B);
+    }
+
+
+    /**
+    * \brief IsSorted
+    *
+    * \return bool: true if the built-in dino list is strictly sorted by the case folded dino tag, otherwise false
+    */
+    static constexpr bool IsSorted(void)
+    {
+        bool result = true;
+
+        for (size_t index = 1u; index < (sizeof(Defaults_Species) / sizeof(Defaults_Species[0])); index++)
+        {
+            result = result && (0 > CompareTags(Defaults_Species[index - 1u].DinoTag, Defaults_Species[index].DinoTag));
+        }
+
+        return result;
+    }
+
+    /* the configuration is merged with the built-in dino list in one pass over both sorted lists */
+    static_assert(true == IsSorted(), "the built-in dino list has to be sorted case insensitive by the dino tag");
+
+
+    /* ===================================== [definition of global functions] ===================================== */
+
+
+    /**
+    * \brief GetSpecies
+    *
+    * \param[out] Count the number of built-in entries
+    * \return const Species_t* the built-in dino list, sorted case insensitive by the dino tag
+    */
+    const Species_t* GetSpecies(size_t* Count)
+    {
+        *Count = sizeof(Defaults_Species) / sizeof(Defaults_Species[0]);
+
+        return Defaults_Species;
+    }
+
+
+    /**
+    * \brief GetFoods
+    *
+    * \param[out] Count the number of built-in foods
+    * \return const char* const* the built-in food list, blueprints in the format of config.json
+    */
+    const char* const* GetFoods(size_t* Count)
+    {
+        *Count = sizeof(Defaults_Foods) / sizeof(Defaults_Foods[0]);
+
+        return Defaults_Foods;
+    }
+}
+
+/* =================================================[end of file]================================================= */
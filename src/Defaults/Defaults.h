@@ -0,0 +1,63 @@
+/*****************************************************************************************************************
+* Copyright (C) 2019 by Matthias Birnthaler                                                                      *
+*                                                                                                                *
+* This file is part of the Cuddle Plugin for Ark Server API                                                      *
+*                                                                                                                *
+*    This program is free software : you can redistribute it and/or modify                                       *
+*    it under the terms of the GNU General Public License as published by                                        *
+*    the Free Software Foundation, either version 3 of the License, or                                           *
+*    (at your option) any later version.                                                                         *
+*                                                                                                                *
+*    This program is distributed in the hope that it will be useful,                                             *
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of                                              *
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the                                                 *
+*    GNU General Public License for more details.                                                                *
+*                                                                                                                *
+*    You should have received a copy of the GNU General Public License                                           *
+*    along with this program.If not, see <https://www.gnu.org/licenses/>.                                        *
+*                                                                                                                *
+*****************************************************************************************************************/
+
+/**
+* \file Defaults.h
+* \author Matthias Birnthaler Matthias-Birnthaler@outlook.com
+* \date 18 October 2026
+* \brief Built-in configuration of the vanilla species and foods
+*
+* The configuration of config.json is layered on top of the built-in configuration,
+* so the plugin works without a configuration file.
+*/
+
+
+#ifndef DEFAULTS_H
+#define DEFAULTS_H
+
+/* ================================================[includes]================================================ */
+
+#include <cstddef>
+
+
+namespace Defaults {
+
+    /* ============================================ [type definitions] ============================================ */
+
+    /** \brief built-in entry of the dino list */
+    struct Species_t {
+        /** \brief the dino tag */
+        const char* DinoTag;
+        /** \brief the cuddle interval time in minutes */
+        float CuddleIntervalTime;
+        /** \brief the increase per cuddle in floating point representation */
+        float CuddleIncreasePercent;
+    };
+
+    /* ================================================[declaration of public functions]========================= */
+
+    extern const Species_t* GetSpecies(size_t* Count);
+    extern const char* const* GetFoods(size_t* Count);
+}
+
+
+#endif /* DEFAULTS_H */
+
+/* =================================================[end of file]================================================= */
@@ -0,0 +1,316 @@
+/*****************************************************************************************************************
+* Copyright (C) 2019 by Matthias Birnthaler                                                                      *
+*                                                                                                                *
+* This file is part of the Cuddle Plugin for Ark Server API                                                      *
+*                                                                                                                *
+*    This program is free software : you can redistribute it and/or modify                                       *
+*    it under the terms of the GNU General Public License as published by                                        *
+*    the Free Software Foundation, either version 3 of the License, or                                           *
+*    (at your option) any later version.                                                                         *
+*                                                                                                                *
+*    This program is distributed in the hope that it will be useful,                                             *
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of                                              *
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the                                                 *
+*    GNU General Public License for more details.                                                                *
+*                                                                                                                *
+*    You should have received a copy of the GNU General Public License                                           *
+*    along with this program.If not, see <https://www.gnu.org/licenses/>.                                        *
+*                                                                                                                *
+*****************************************************************************************************************/
+
+/**
+* \file Handoff.cpp
+* \author Matthias Birnthaler Matthias-Birnthaler@outlook.com
+* \date 18 October 2026
+* \brief Implementation of the state handoff between two loads of the plugin
+*
+* Before the plugin is unloaded the live state (the cuddle schedule and the runtime switches) is written
+* into a versioned blob. The next load within the same server process rehydrates the state from the blob,
+* so a new build of the plugin can be loaded without a server restart. A blob left behind by a previous server
+* run is discarded on the next cold start, the schedule is then taken from the journal.
+*/
+
+/* ================================================ [includes] ================================================ */
+#include "Handoff.h"
+#include "Hooks.h"
+#include "Journal.h"
+#include "Tracker.h"
+#include "Util.h"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+
+namespace Handoff
+{
+    /* ============================================ [type definitions] ============================================ */
+    /** \brief magic number of the handoff blob "CDH1" */
+    #define HANDOFF_MAGIC       0x31484443u
+    /** \brief version of the handoff blob, to be increased with every change of the layout */
+    #define HANDOFF_VERSION     2u
+
+    /* the schedule records are copied bytewise into and out of the blob */
+    static_assert(std::is_trivially_copyable_v<Journal::Record_t>, "Journal::Record_t must be trivially copyable");
+
+    /** \brief header of the handoff blob, followed by the schedule records and the switched off names */
+    struct Header_t {
+        /** \brief magic number of the blob */
+        uint32_t Magic;
+        /** \brief version of the blob */
+        uint32_t Version;
+        /** \brief id of the server process that wrote the blob */
+        uint32_t ProcessId;
+        /** \brief number of schedule records */
+        uint32_t RecordCount;
+        /** \brief size of the switched off features and hooks ("feature:<name>\n" / "hook:<name>\n") in bytes */
+        uint32_t NamesSize;
+        /** \brief CRC32 of the payload behind the header */
+        uint32_t Checksum;
+        /** \brief creation time of the server process that wrote the blob, tells apart a reused process id */
+        uint64_t ProcessStartTime;
+    };
+
+    /* =============================================== [local data] =============================================== */
+
+    /* ===================================== [prototype of local functions] ======================================= */
+
+    static std::string GetHandoffPath(void);
+    static uint64_t GetProcessStartTime(void);
+    static std::string CollectSwitchedOffNames(void);
+    static void RestoreSwitchedOffNames(const std::string& Names);
+
+
+    /**
+    * \brief GetHandoffPath
+    *
+    * \return std::string the path of the handoff blob
+    */
+    static std::string GetHandoffPath(void)
+    {
+        return Util::GetPluginDirectory() + "CuddlePlugin.handoff";
+    }
+
+
+    /**
+    * \brief GetProcessStartTime
+    *
+    * The process id alone does not identify a server run, the operating system reuses ids after a restart.
+    *
+    * \return uint64_t the creation time of the server process, 0 if it can not be determined
+    */
+    static uint64_t GetProcessStartTime(void)
+    {
+        uint64_t result = 0u;
+        FILETIME creation;
+        FILETIME exit;
+        FILETIME kernel;
+        FILETIME user;
+
+        if (FALSE != GetProcessTimes(GetCurrentProcess(), &creation, &exit, &kernel, &user))
+        {
+            result = (static_cast<uint64_t>(creation.dwHighDateTime) << 32) | creation.dwLowDateTime;
+        }
+
+        return result;
+    }
+
+
+    /**
+    * \brief CollectSwitchedOffNames
+    *
+    * This function collects the names of all features and hooks that are switched off at runtime.
+    * The names instead of the ids are handed over, so a new build may reorder or extend them.
+    *
+    * \return std::string the names, one per line
+    */
+    static std::string CollectSwitchedOffNames(void)
+    {
+        std::stringstream names;
+
+        for (int index = 0; index < Util::FEATURE_COUNT; index++)
+        {
+            if (false == Util::IsFeatureEnabled(static_cast<Util::Feature_t>(index)))
+            {
+                names << "feature:" << Util::GetFeatureName(static_cast<Util::Feature_t>(index)) << "\n";
+            }
+        }
+
+        for (int index = 0; index < HOOK_COUNT; index++)
+        {
+            if (false == IsHookEnabled(static_cast<HookId_t>(index)))
+            {
+                names << "hook:" << GetHookName(static_cast<HookId_t>(index)) << "\n";
+            }
+        }
+
+        return names.str();
+    }
+
+
+    /**
+    * \brief RestoreSwitchedOffNames
+    *
+    * This function switches off all handed over features and hooks that are known to this build
+    *
+    * \param[in] Names the names, one per line
+    * \return void
+    */
+    static void RestoreSwitchedOffNames(const std::string& Names)
+    {
+        std::stringstream names(Names);
+        std::string line;
+
+        while (std::getline(names, line))
+        {
+            Util::Feature_t feature;
+            HookId_t hook;
+
+            if ((0 == line.rfind("feature:", 0)) && (true == Util::FindFeature(line.substr(8), &feature)))
+            {
+                Util::SetFeatureEnabled(feature, false);
+            }
+            else if ((0 == line.rfind("hook:", 0)) && (true == FindHook(line.substr(5), &hook)))
+            {
+                SetHookEnabled(hook, false);
+            }
+        }
+    }
+
+
+    /* ===================================== [definition of global functions] ===================================== */
+
+    /**
+    * \brief Save
+    *
+    * This function writes the live state of the plugin into the handoff blob
+    *
+    * \return bool: true if the blob was written, otherwise false
+    */
+    bool Save(void)
+    {
+        bool result = false;
+        const std::vector<Journal::Record_t> records = Tracker::ExportSchedule();
+        const std::string names = CollectSwitchedOffNames();
+        std::vector<char> payload(records.size() * sizeof(Journal::Record_t) + names.size());
+        Header_t header;
+
+        if (false == records.empty())
+        {
+            memcpy(payload.data(), records.data(), records.size() * sizeof(Journal::Record_t));
+        }
+        memcpy(payload.data() + records.size() * sizeof(Journal::Record_t), names.data(), names.size());
+
+        header.Magic = HANDOFF_MAGIC;
+        header.Version = HANDOFF_VERSION;
+        header.ProcessId = static_cast<uint32_t>(GetCurrentProcessId());
+        header.ProcessStartTime = GetProcessStartTime();
+        header.RecordCount = static_cast<uint32_t>(records.size());
+        header.NamesSize = static_cast<uint32_t>(names.size());
+        header.Checksum = Journal::Crc32(payload.data(), payload.size());
+
+        std::ofstream file{ GetHandoffPath(), std::ios::binary | std::ios::trunc };
+
+        if (true == file.is_open())
+        {
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            file.write(payload.data(), payload.size());
+            file.close();
+
+            result = !file.fail();
+        }
+
+        if (true == result)
+        {
+            Log::GetLog()->info("handed over {} scheduled dinos", records.size());
+        }
+        else
+        {
+            Log::GetLog()->error("can not write {}", GetHandoffPath());
+        }
+
+        return result;
+    }
+
+
+    /**
+    * \brief Restore
+    *
+    * This function rehydrates the live state of the plugin from the handoff blob of the previous load.
+    * It is called after the journal has been replayed and consumes the blob in any case. A blob of another
+    * server run or of another version is discarded, the schedule replayed from the journal is kept then.
+    *
+    * \return bool: true if the state was restored, otherwise false
+    */
+    bool Restore(void)
+    {
+        bool result = false;
+        const std::string path = GetHandoffPath();
+        std::ifstream file{ path, std::ios::binary };
+
+        if (true == file.is_open())
+        {
+            std::vector<char> blob((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+            Header_t header;
+
+            file.close();
+
+            if (blob.size() >= sizeof(header))
+            {
+                memcpy(&header, blob.data(), sizeof(header));
+
+                const size_t recordsSize = static_cast<size_t>(header.RecordCount) * sizeof(Journal::Record_t);
+                const char* payload = blob.data() + sizeof(header);
+                const size_t payloadSize = blob.size() - sizeof(header);
+
+                if ((HANDOFF_MAGIC != header.Magic) || (HANDOFF_VERSION != header.Version))
+                {
+                    Log::GetLog()->warn("ignoring handoff blob of version {}", header.Version);
+                }
+                else if ((static_cast<uint32_t>(GetCurrentProcessId()) != header.ProcessId) || (GetProcessStartTime() != header.ProcessStartTime))
+                {
+                    /* the blob of a previous server run is older than the journal */
+                    Log::GetLog()->info("discarding handoff blob of a previous server run");
+                }
+                else if ((payloadSize != recordsSize + header.NamesSize) || (Journal::Crc32(payload, payloadSize) != header.Checksum))
+                {
+                    Log::GetLog()->error("ignoring corrupt handoff blob");
+                }
+                else
+                {
+                    std::vector<Journal::Record_t> records(header.RecordCount);
+
+                    if (0 != recordsSize)
+                    {
+                        memcpy(records.data(), payload, recordsSize);
+                    }
+
+                    Tracker::ImportSchedule(records);
+                    RestoreSwitchedOffNames(std::string(payload + recordsSize, header.NamesSize));
+
+                    Log::GetLog()->info("took over {} scheduled dinos", records.size());
+                    result = true;
+                }
+            }
+        }
+
+        std::error_code error;
+
+        /* a missing blob is not an error, a blob that can not be read must not outlive the cold start either */
+        std::filesystem::remove(path, error);
+
+        if (error)
+        {
+            Log::GetLog()->warn("can not remove {}, {}", path, error.message());
+        }
+
+        return result;
+    }
+}
+
+
+/* =================================================[end of file]================================================= */
@@ -0,0 +1,356 @@
+/*****************************************************************************************************************
+* Copyright (C) 2019 by Matthias Birnthaler                                                                      *
+*                                                                                                                *
+* This file is part of the Cuddle Plugin for Ark Server API                                                      *
+*                                                                                                                *
+*    This program is free software : you can redistribute it and/or modify                                       *
+*    it under the terms of the GNU General Public License as published by                                        *
+*    the Free Software Foundation, either version 3 of the License, or                                           *
+*    (at your option) any later version.                                                                         *
+*                                                                                                                *
+*    This program is distributed in the hope that it will be useful,                                             *
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of                                              *
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the                                                 *
+*    GNU General Public License for more details.                                                                *
+*                                                                                                                *
+*    You should have received a copy of the GNU General Public License                                           *
+*    along with this program.If not, see <https://www.gnu.org/licenses/>.                                        *
+*                                                                                                                *
+*****************************************************************************************************************/
+
+/**
+* \file Imprint.cpp
+* \author Matthias Birnthaler Matthias-Birnthaler@outlook.com
+* \date 18 October 2026
+* \brief Shared arithmetic of the imprinting quality
+*
+* The batch evaluation is implemented with AVX2, SSE2 and as scalar fallback. The implementation is selected
+* once at load by the features of the CPU. All implementations give the same results as the scalar kernel.
+* The CPU features are read with the intrinsics of MSVC, or of GCC and Clang for the host tests.
+*/
+
+/* ================================================ [includes] ================================================ */
+#include "Imprint.h"
+
+#include <cstdint>
+#include <immintrin.h>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+
+
+namespace Imprint {
+
+    /* ============================================ [type definitions] ============================================ */
+
+#if defined(_MSC_VER)
+    /** \brief MSVC generates AVX2 instructions for the intrinsics without a target option */
+    #define IMPRINT_TARGET_AVX2
+#else
+    /** \brief GCC and Clang only generate AVX2 instructions in functions that target AVX2 */
+    #define IMPRINT_TARGET_AVX2     __attribute__((target("avx2")))
+#endif
+
+    /** \brief implementation of the batch evaluation */
+    typedef void(*BatchFunction_t)(const BatchView_t& Batch, double Now, size_t Begin);
+
+    /** \brief selectable implementation of the batch evaluation */
+    struct BatchImplementation_t {
+        /** \brief name of the implementation */
+        const char* Name;
+        /** \brief the implementation */
+        BatchFunction_t Function;
+    };
+
+    /* ===================================== [prototype of local functions] ======================================= */
+
+    static void EvaluateBatchScalar(const BatchView_t& Batch, double Now, size_t Begin);
+    static void EvaluateBatchSse2(const BatchView_t& Batch, double Now, size_t Begin);
+    IMPRINT_TARGET_AVX2 static void EvaluateBatchAvx2(const BatchView_t& Batch, double Now, size_t Begin);
+    static void ReadCpuid(int Leaf, int SubLeaf, int Info[4]);
+    static uint64_t ReadXcr0(void);
+    static bool IsSse2Supported(void);
+    static bool IsAvx2Supported(void);
+    static BatchImplementation_t SelectBatchImplementation(void);
+
+    /* =============================================== [local data] =============================================== */
+
+    /** \brief The batch evaluation selected for the CPU */
+    static const BatchImplementation_t Imprint_Batch = SelectBatchImplementation();
+
+
+    /* ===================================== [definition of local functions] ====================================== */
+
+
+    /**
+    * \brief EvaluateBatchScalar
+    *
+    * This function evaluates the batch from the index Begin with the scalar kernel
+    *
+    * \param[in] Batch the batch of dinos
+    * \param[in] Now the current server time in secounds
+    * \param[in] Begin the first index to be evaluated
+    * \return void
+    */
+    static void EvaluateBatchScalar(const BatchView_t& Batch, double Now, size_t Begin)
+    {
+        for (size_t index = Begin; index < Batch.Count; index++)
+        {
+            const float quality = AddQuality(Batch.Quality[index], Batch.Increase[index]);
+
+            Batch.Quality[index] = quality;
+            Batch.Deadline[index] = Now + static_cast<double>(IsFullyImprinted(quality) ? Batch.MaturationTime[index] : Batch.Interval[index]);
+        }
+    }
+
+
+    /**
+    * \brief EvaluateBatchSse2
+    *
+    * This function evaluates the batch with SSE2, four dinos per step. The remainder is evaluated scalar.
+    *
+    * \param[in] Batch the batch of dinos
+    * \param[in] Now the current server time in secounds
+    * \param[in] Begin the first index to be evaluated
+    * \return void
+    */
+    static void EvaluateBatchSse2(const BatchView_t& Batch, double Now, size_t Begin)
+    {
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 one = _mm_set1_ps(1.0f);
+        const __m128 full = _mm_set1_ps(1.0f - IMPRINT_EPSILON);
+        const __m128d now = _mm_set1_pd(Now);
+        size_t index = Begin;
+
+        for (; (index + 4u) <= Batch.Count; index += 4u)
+        {
+            /* _mm_max_ps returns the second operand for NaN, like ClampQuality */
+            const __m128 previous = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(&Batch.Quality[index]), zero), one);
+            const __m128 sum = _mm_min_ps(_mm_max_ps(_mm_add_ps(previous, _mm_loadu_ps(&Batch.Increase[index])), zero), one);
+            const __m128 isFull = _mm_cmpge_ps(sum, full);
+            const __m128 quality = _mm_or_ps(_mm_and_ps(isFull, one), _mm_andnot_ps(isFull, sum));
+            const __m128 delay = _mm_or_ps(_mm_and_ps(isFull, _mm_loadu_ps(&Batch.MaturationTime[index])),
+                _mm_andnot_ps(isFull, _mm_loadu_ps(&Batch.Interval[index])));
+
+            _mm_storeu_ps(&Batch.Quality[index], quality);
+            _mm_storeu_pd(&Batch.Deadline[index], _mm_add_pd(now, _mm_cvtps_pd(delay)));
+            _mm_storeu_pd(&Batch.Deadline[index + 2u], _mm_add_pd(now, _mm_cvtps_pd(_mm_movehl_ps(delay, delay))));
+        }
+
+        EvaluateBatchScalar(Batch, Now, index);
+    }
+
+
+    /**
+    * \brief EvaluateBatchAvx2
+    *
+    * This function evaluates the batch with AVX2, eight dinos per step. The remainder is evaluated with SSE2.
+    *
+    * \param[in] Batch the batch of dinos
+    * \param[in] Now the current server time in secounds
+    * \param[in] Begin the first index to be evaluated
+    * \return void
+    */
+    IMPRINT_TARGET_AVX2 static void EvaluateBatchAvx2(const BatchView_t& Batch, double Now, size_t Begin)
+    {
+        const __m256 zero = _mm256_setzero_ps();
+        const __m256 one = _mm256_set1_ps(1.0f);
+        const __m256 full = _mm256_set1_ps(1.0f - IMPRINT_EPSILON);
+        const __m256d now = _mm256_set1_pd(Now);
+        size_t index = Begin;
+
+        for (; (index + 8u) <= Batch.Count; index += 8u)
+        {
+            const __m256 previous = _mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(&Batch.Quality[index]), zero), one);
+            const __m256 sum = _mm256_min_ps(_mm256_max_ps(_mm256_add_ps(previous, _mm256_loadu_ps(&Batch.Increase[index])), zero), one);
+            const __m256 isFull = _mm256_cmp_ps(sum, full, _CMP_GE_OQ);
+            const __m256 quality = _mm256_blendv_ps(sum, one, isFull);
+            const __m256 delay = _mm256_blendv_ps(_mm256_loadu_ps(&Batch.Interval[index]), _mm256_loadu_ps(&Batch.MaturationTime[index]), isFull);
+
+            _mm256_storeu_ps(&Batch.Quality[index], quality);
+            _mm256_storeu_pd(&Batch.Deadline[index], _mm256_add_pd(now, _mm256_cvtps_pd(_mm256_castps256_ps128(delay))));
+            _mm256_storeu_pd(&Batch.Deadline[index + 4u], _mm256_add_pd(now, _mm256_cvtps_pd(_mm256_extractf128_ps(delay, 1))));
+        }
+
+        _mm256_zeroupper();
+
+        EvaluateBatchSse2(Batch, Now, index);
+    }
+
+
+    /**
+    * \brief ReadCpuid
+    *
+    * \param[in] Leaf the leaf of the CPUID instruction
+    * \param[in] SubLeaf the sub leaf of the CPUID instruction
+    * \param[out] Info the registers EAX, EBX, ECX and EDX
+    * \return void
+    */
+    static void ReadCpuid(int Leaf, int SubLeaf, int Info[4])
+    {
+#if defined(_MSC_VER)
+        __cpuidex(Info, Leaf, SubLeaf);
+#else
+        unsigned int registers[4] = { 0u, 0u, 0u, 0u };
+
+        __cpuid_count(static_cast<unsigned int>(Leaf), static_cast<unsigned int>(SubLeaf), registers[0], registers[1], registers[2], registers[3]);
+
+        for (int index = 0; index < 4; index++)
+        {
+            Info[index] = static_cast<int>(registers[index]);
+        }
+#endif
+    }
+
+
+    /**
+    * \brief ReadXcr0
+    *
+    * This function reads the register XCR0, it must only be called if the CPU reports OSXSAVE
+    *
+    * \return uint64_t the states the operating system saves on a context switch
+    */
+    static uint64_t ReadXcr0(void)
+    {
+#if defined(_MSC_VER)
+        return _xgetbv(0);
+#else
+        uint32_t low = 0u;
+        uint32_t high = 0u;
+
+        __asm__ volatile ("xgetbv" : "=a"(low), "=d"(high) : "c"(0));
+
+        return (static_cast<uint64_t>(high) << 32u) | low;
+#endif
+    }
+
+
+    /**
+    * \brief IsSse2Supported
+    *
+    * \return bool: true if the CPU supports SSE2, otherwise false
+    */
+    static bool IsSse2Supported(void)
+    {
+        int info[4] = { 0 };
+
+        ReadCpuid(1, 0, info);
+
+        return (0 != (info[3] & (1 << 26)));
+    }
+
+
+    /**
+    * \brief IsAvx2Supported
+    *
+    * \return bool: true if the CPU and the operating system support AVX2, otherwise false
+    */
+    static bool IsAvx2Supported(void)
+    {
+        int info[4] = { 0 };
+        bool result = false;
+
+        ReadCpuid(0, 0, info);
+
+        if (7 <= info[0])
+        {
+            ReadCpuid(1, 0, info);
+
+            /* OSXSAVE and AVX, and the operating system saves the YMM registers */
+            if ((0 != (info[2] & (1 << 27))) && (0 != (info[2] & (1 << 28))) && (6u == (ReadXcr0() & 6u)))
+            {
+                ReadCpuid(7, 0, info);
+                result = (0 != (info[1] & (1 << 5)));
+            }
+        }
+
+        return result;
+    }
+
+
+    /**
+    * \brief SelectBatchImplementation
+    *
+    * This function selects the fastest batch evaluation that is supported by the CPU, the scalar
+    * evaluation is used if neither AVX2 nor SSE2 is supported
+    *
+    * \return BatchImplementation_t the selected implementation
+    */
+    static BatchImplementation_t SelectBatchImplementation(void)
+    {
+        BatchImplementation_t result = { "scalar", &EvaluateBatchScalar };
+
+        if (true == IsAvx2Supported())
+        {
+            result = { "avx2", &EvaluateBatchAvx2 };
+        }
+        else if (true == IsSse2Supported())
+        {
+            result = { "sse2", &EvaluateBatchSse2 };
+        }
+
+        return result;
+    }
+
+
+    /* ===================================== [definition of global functions] ===================================== */
+
+
+    /**
+    * \brief ApplyIncrease
+    *
+    * This function applies the imprint kernel to a batch of dinos (structure of arrays)
+    *
+    * \param[in,out] Quality the imprinting qualities, updated in place
+    * \param[in] Increase the increases
+    * \param[out] Amount the amounts that are really added, may be nullptr
+    * \param[in] Count the number of dinos
+    * \return void
+    */
+    void ApplyIncrease(float* Quality, const float* Increase, float* Amount, size_t Count)
+    {
+        for (size_t index = 0; index < Count; index++)
+        {
+            const float quality = AddQuality(Quality[index], Increase[index]);
+
+            if (nullptr != Amount)
+            {
+                Amount[index] = quality - ClampQuality(Quality[index]);
+            }
+
+            Quality[index] = quality;
+        }
+    }
+
+
+    /**
+    * \brief EvaluateBatch
+    *
+    * This function applies one cuddle to every dino of the batch and computes the next cuddle time.
+    * Dinos that are fully imprinted afterwards get the total maturation time as interval.
+    *
+    * \param[in] Batch the batch of dinos
+    * \param[in] Now the current server time in secounds
+    * \return void
+    */
+    void EvaluateBatch(const BatchView_t& Batch, double Now)
+    {
+        Imprint_Batch.Function(Batch, Now, 0u);
+    }
+
+
+    /**
+    * \brief GetBatchImplementation
+    *
+    * \return const char* the name of the selected batch evaluation
+    */
+    const char* GetBatchImplementation(void)
+    {
+        return Imprint_Batch.Name;
+    }
+}
+
+/* =================================================[end of file]================================================= */
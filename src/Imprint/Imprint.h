@@ -0,0 +1,132 @@
+/*****************************************************************************************************************
+* Copyright (C) 2019 by Matthias Birnthaler                                                                      *
+*                                                                                                                *
+* This file is part of the Cuddle Plugin for Ark Server API                                                      *
+*                                                                                                                *
+*    This program is free software : you can redistribute it and/or modify                                       *
+*    it under the terms of the GNU General Public License as published by                                        *
+*    the Free Software Foundation, either version 3 of the License, or                                           *
+*    (at your option) any later version.                                                                         *
+*                                                                                                                *
+*    This program is distributed in the hope that it will be useful,                                             *
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of                                              *
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the                                                 *
+*    GNU General Public License for more details.                                                                *
+*                                                                                                                *
+*    You should have received a copy of the GNU General Public License                                           *
+*    along with this program.If not, see <https://www.gnu.org/licenses/>.                                        *
+*                                                                                                                *
+*****************************************************************************************************************/
+
+/**
+* \file Imprint.h
+* \author Matthias Birnthaler Matthias-Birnthaler@outlook.com
+* \date 18 October 2026
+* \brief Shared arithmetic of the imprinting quality
+*
+* All imprint updates of the plugin (hooks, automatic imprint and admin commands) go through this kernel,
+* so the clamping at 0 and 1 is the same everywhere. The scalar kernel is inline and free of branches
+* (min, max and select), so the batch functions can be vectorized.
+*/
+
+
+#ifndef IMPRINT_H
+#define IMPRINT_H
+
+/* ================================================[includes]================================================ */
+
+#include <algorithm>
+#include <cstddef>
+
+
+namespace Imprint {
+
+    /* ============================================ [type definitions] ============================================ */
+
+    /** \brief imprinting qualities within this distance below 1 are treated as fully imprinted */
+    #define IMPRINT_EPSILON     0.000001f
+
+    /** \brief structure of arrays view of a batch of dinos */
+    struct BatchView_t {
+        /** \brief the imprinting qualities, updated in place */
+        float* Quality;
+        /** \brief the increases per cuddle */
+        const float* Increase;
+        /** \brief the cuddle interval times in secounds */
+        const float* Interval;
+        /** \brief the total maturation times in secounds, used as interval when fully imprinted */
+        const float* MaturationTime;
+        /** \brief the next cuddle times in secounds (output) */
+        double* Deadline;
+        /** \brief the number of dinos */
+        size_t Count;
+    };
+
+    /* ================================================[declaration of public functions]========================= */
+
+    extern void ApplyIncrease(float* Quality, const float* Increase, float* Amount, size_t Count);
+    extern void EvaluateBatch(const BatchView_t& Batch, double Now);
+    extern const char* GetBatchImplementation(void);
+
+
+    /* ================================================[definition of inline functions]========================== */
+
+    /**
+    * \brief ClampQuality
+    *
+    * \param[in] Quality the imprinting quality
+    * \return float the imprinting quality clamped to 0..1, NaN results in 0
+    */
+    inline float ClampQuality(float Quality)
+    {
+        return std::min(1.0f, std::max(0.0f, Quality));
+    }
+
+
+    /**
+    * \brief AddQuality
+    *
+    * This function adds an increase to an imprinting quality. The result is clamped to 0..1, rounding
+    * residues just below 1 are snapped to exactly 1.
+    *
+    * \param[in] Quality the imprinting quality
+    * \param[in] Increase the increase (negative values decrease the quality)
+    * \return float the new imprinting quality
+    */
+    inline float AddQuality(float Quality, float Increase)
+    {
+        const float quality = ClampQuality(ClampQuality(Quality) + Increase);
+
+        return (quality >= (1.0f - IMPRINT_EPSILON)) ? 1.0f : quality;
+    }
+
+
+    /**
+    * \brief GetAddedAmount
+    *
+    * \param[in] Quality the imprinting quality
+    * \param[in] Increase the increase
+    * \return float the amount that is really added by AddQuality
+    */
+    inline float GetAddedAmount(float Quality, float Increase)
+    {
+        return AddQuality(Quality, Increase) - ClampQuality(Quality);
+    }
+
+
+    /**
+    * \brief IsFullyImprinted
+    *
+    * \param[in] Quality the imprinting quality
+    * \return bool: true if the dino is fully imprinted, otherwise false
+    */
+    inline bool IsFullyImprinted(float Quality)
+    {
+        return (Quality >= (1.0f - IMPRINT_EPSILON));
+    }
+}
+
+
+#endif /* IMPRINT_H */
+
+/* =================================================[end of file]================================================= */
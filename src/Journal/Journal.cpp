@@ -0,0 +1,619 @@
+/*****************************************************************************************************************
+* Copyright (C) 2019 by Matthias Birnthaler                                                                      *
+*                                                                                                                *
+* This file is part of the Cuddle Plugin for Ark Server API                                                      *
+*                                                                                                                *
+*    This program is free software : you can redistribute it and/or modify                                       *
+*    it under the terms of the GNU General Public License as published by                                        *
+*    the Free Software Foundation, either version 3 of the License, or                                           *
+*    (at your option) any later version.                                                                         *
+*                                                                                                                *
+*    This program is distributed in the hope that it will be useful,                                             *
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of                                              *
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the                                                 *
+*    GNU General Public License for more details.                                                                *
+*                                                                                                                *
+*    You should have received a copy of the GNU General Public License                                           *
+*    along with this program.If not, see <https://www.gnu.org/licenses/>.                                        *
+*                                                                                                                *
+*****************************************************************************************************************/
+
+/**
+* \file Journal.cpp
+* \author Matthias Birnthaler Matthias-Birnthaler@outlook.com
+* \date 18 October 2026
+* \brief Implementation of the crash safe imprint journal
+*
+* The journal is an append only file of checksummed records. The records are collected on the game thread
+* and written in batches by a writer thread that flushes them to disk. After a configured number of records
+* the journal is compacted into a snapshot of the schedule and truncated. Both files carry the generation of
+* the last compaction, a journal older than the snapshot is already contained in it and is not replayed.
+*/
+
+/* ================================================ [includes] ================================================ */
+#include "Journal.h"
+#include "Memory.h"
+
+#include "API/ARK/Ark.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdio>
+#include <filesystem>
+#include <io.h>
+#include <mutex>
+#include <thread>
+
+
+namespace Journal {
+
+    /* ============================================ [type definitions] ============================================ */
+    /** \brief magic number of the journal file "CDJ1" */
+    #define JOURNAL_MAGIC       0x314A4443u
+    /** \brief magic number of the snapshot file "CDS1" */
+    #define SNAPSHOT_MAGIC      0x31534443u
+    /** \brief version of the record layout */
+    #define JOURNAL_VERSION     2u
+    /** \brief lower bound of the flush interval, a zero interval would busy loop the writer thread */
+    #define JOURNAL_MIN_FLUSH_INTERVAL  std::chrono::milliseconds(10)
+
+    /** \brief header of the journal and the snapshot file */
+    struct FileHeader_t {
+        /** \brief magic number of the file */
+        uint32_t Magic;
+        /** \brief version of the record layout */
+        uint32_t Version;
+        /** \brief generation of the compaction the file belongs to */
+        uint64_t Generation;
+    };
+
+    /* =============================================== [local data] =============================================== */
+
+    /** \brief lookup table of the CRC32 (polynom 0xEDB88320) */
+    static const std::array<uint32_t, 256> Journal_CrcTable = []()
+    {
+        std::array<uint32_t, 256> table{};
+
+        for (uint32_t index = 0; index < 256; index++)
+        {
+            uint32_t crc = index;
+
+            for (int bit = 0; bit < 8; bit++)
+            {
+                crc = (crc >> 1) ^ ((crc & 1u) * 0xEDB88320u);
+            }
+            table[index] = crc;
+        }
+        return table;
+    }();
+
+    /** \brief path of the journal file */
+    static std::string Journal_Path;
+
+    /** \brief path of the snapshot file */
+    static std::string Journal_SnapshotPath;
+
+    /** \brief the opened journal file, only accessed by the writer thread after Open */
+    static FILE* Journal_File = nullptr;
+
+    /** \brief the writer thread */
+    static std::thread Journal_Writer;
+
+    /** \brief protects the pending records, the pending snapshot and the stop request */
+    static std::mutex Journal_Mutex;
+
+    /** \brief wakes up the writer thread */
+    static std::condition_variable Journal_Signal;
+
+    /** \brief records that are not yet written */
+    static std::vector<Record_t> Journal_Pending;
+
+    /** \brief snapshot that is not yet written */
+    static std::vector<Record_t> Journal_Snapshot;
+
+    /** \brief a snapshot is waiting for the writer thread */
+    static bool Journal_IsSnapshotPending = false;
+
+    /** \brief the writer thread shall write all pending records and stop */
+    static bool Journal_IsStopRequested = false;
+
+    /** \brief the journal is opened */
+    static bool Journal_IsOpen = false;
+
+    /** \brief number of records since the last compaction, only accessed by the game thread */
+    static uint32_t Journal_RecordCount = 0;
+
+    /** \brief number of records after which the journal is compacted */
+    static uint32_t Journal_CompactionRecords = 0;
+
+    /** \brief the time between two flushes of the journal */
+    static std::chrono::milliseconds Journal_FlushInterval;
+
+    /** \brief generation of the current snapshot and journal, only accessed by the writer thread after open */
+    static uint64_t Journal_Generation = 0;
+
+    /* ===================================== [prototype of local functions] ======================================= */
+
+    static uint32_t ChecksumRecord(const Record_t& Record);
+    static bool ReplayFile(const std::string& Path, uint32_t Magic, uint64_t MinGeneration, const std::function<void(const Record_t&)>& Replay, uint32_t* Count, uint64_t* Generation);
+    static FILE* CreateJournalFile(const std::string& Path, const char* Mode, uint32_t Magic, uint64_t Generation);
+    static void WriteRecords(FILE* File, std::vector<Record_t>& Records);
+    static void SyncFile(FILE* File);
+    static bool WriteSnapshot(std::vector<Record_t>& Snapshot);
+    static void WriterThread(void);
+    static size_t GetBufferMemory(void);
+
+
+    /**
+    * \brief ChecksumRecord
+    *
+    * This function calculates the CRC32 over all members of the record except of the checksum itself
+    *
+    * \param[in] Record the record
+    * \return uint32_t the checksum of the record
+    */
+    static uint32_t ChecksumRecord(const Record_t& Record)
+    {
+        return Crc32(&Record, offsetof(Record_t, Checksum));
+    }
+
+
+    /**
+    * \brief ReplayFile
+    *
+    * This function reads a journal or snapshot file in one sequential pass and replays every valid record.
+    * The replay stops at the first record with an invalid checksum (torn write of a crash).
+    * A file of an older generation than MinGeneration is not replayed.
+    *
+    * \param[in] Path the path of the file
+    * \param[in] Magic the expected magic number of the file
+    * \param[in] MinGeneration the oldest generation that is replayed
+    * \param[in] Replay the callback for every valid record
+    * \param[out] Count the number of replayed records
+    * \param[out] Generation the generation of the file, 0 if it is missing or invalid
+    * \return bool: true if the file was read completely, false if it is missing, invalid, outdated or has a torn tail
+    */
+    static bool ReplayFile(const std::string& Path, uint32_t Magic, uint64_t MinGeneration, const std::function<void(const Record_t&)>& Replay, uint32_t* Count, uint64_t* Generation)
+    {
+        bool result = false;
+        FILE* file = fopen(Path.c_str(), "rb");
+
+        *Count = 0;
+        *Generation = 0;
+
+        if (nullptr != file)
+        {
+            FileHeader_t header;
+            Record_t record;
+
+            if ((1 == fread(&header, sizeof(header), 1, file)) && (Magic == header.Magic) && (JOURNAL_VERSION == header.Version))
+            {
+                *Generation = header.Generation;
+                result = (MinGeneration <= header.Generation);
+
+                if (false == result)
+                {
+                    Log::GetLog()->info("{}: generation {} is older than {}, skipping the file", Path, header.Generation, MinGeneration);
+                }
+
+                while ((true == result) && (1 == fread(&record, sizeof(record), 1, file)))
+                {
+                    if (ChecksumRecord(record) != record.Checksum)
+                    {
+                        Log::GetLog()->warn("{}: invalid record after {} records, dropping the tail", Path, *Count);
+                        result = false;
+                        break;
+                    }
+
+                    Replay(record);
+                    (*Count)++;
+                }
+
+                /* a partial record at the end of the file is a torn write as well */
+                if ((true == result) && ((0 == feof(file)) || (0 != (ftell(file) - sizeof(header)) % sizeof(record))))
+                {
+                    result = false;
+                }
+            }
+
+            fclose(file);
+        }
+
+        return result;
+    }
+
+
+    /**
+    * \brief CreateJournalFile
+    *
+    * This function opens a journal or snapshot file and writes the file header if the file is empty
+    *
+    * \param[in] Path the path of the file
+    * \param[in] Mode the fopen mode ("ab" to append, "wb" to truncate)
+    * \param[in] Magic the magic number of the file
+    * \param[in] Generation the generation written to the header of an empty file
+    * \return FILE* the opened file or nullptr
+    */
+    static FILE* CreateJournalFile(const std::string& Path, const char* Mode, uint32_t Magic, uint64_t Generation)
+    {
+        FILE* file = fopen(Path.c_str(), Mode);
+
+        if (nullptr != file)
+        {
+            fseek(file, 0, SEEK_END);
+
+            if (0 == ftell(file))
+            {
+                const FileHeader_t header = { Magic, JOURNAL_VERSION, Generation };
+                fwrite(&header, sizeof(header), 1, file);
+            }
+        }
+        else
+        {
+            Log::GetLog()->error("can not open {}", Path);
+        }
+
+        return file;
+    }
+
+
+    /**
+    * \brief WriteRecords
+    *
+    * This function checksums and writes a batch of records with a single write
+    *
+    * \param[in] File the destination file
+    * \param[in] Records the records
+    * \return void
+    */
+    static void WriteRecords(FILE* File, std::vector<Record_t>& Records)
+    {
+        for (Record_t& record : Records)
+        {
+            record.Checksum = ChecksumRecord(record);
+        }
+
+        if ((nullptr != File) && (false == Records.empty()))
+        {
+            if (Records.size() != fwrite(Records.data(), sizeof(Record_t), Records.size(), File))
+            {
+                Log::GetLog()->error("can not write {} journal records", Records.size());
+            }
+        }
+    }
+
+
+    /**
+    * \brief SyncFile
+    *
+    * This function flushes a file through the C runtime and the operating system to the disk
+    *
+    * \param[in] File the file
+    * \return void
+    */
+    static void SyncFile(FILE* File)
+    {
+        if (nullptr != File)
+        {
+            fflush(File);
+            _commit(_fileno(File));
+        }
+    }
+
+
+    /**
+    * \brief WriteSnapshot
+    *
+    * This function writes the snapshot of the next generation to a temporary file and replaces the previous
+    * snapshot, afterwards the journal is truncated to the same generation. A crash in between leaves a journal
+    * of the older generation, which is skipped at the next open.
+    *
+    * \param[in] Snapshot the records of the snapshot
+    * \return bool: true if the snapshot was written, otherwise false
+    */
+    static bool WriteSnapshot(std::vector<Record_t>& Snapshot)
+    {
+        bool result = false;
+        const std::string temporaryPath = Journal_SnapshotPath + ".tmp";
+        const uint64_t generation = Journal_Generation + 1u;
+        FILE* file = CreateJournalFile(temporaryPath, "wb", SNAPSHOT_MAGIC, generation);
+
+        if (nullptr != file)
+        {
+            std::error_code error;
+
+            WriteRecords(file, Snapshot);
+            SyncFile(file);
+            fclose(file);
+
+            std::filesystem::rename(temporaryPath, Journal_SnapshotPath, error);
+
+            if (!error)
+            {
+                if (nullptr != Journal_File)
+                {
+                    fclose(Journal_File);
+                }
+                Journal_Generation = generation;
+                Journal_File = CreateJournalFile(Journal_Path, "wb", JOURNAL_MAGIC, Journal_Generation);
+                SyncFile(Journal_File);
+
+                result = true;
+            }
+            else
+            {
+                Log::GetLog()->error("can not replace {}: {}", Journal_SnapshotPath, error.message());
+            }
+        }
+
+        return result;
+    }
+
+
+    /**
+    * \brief WriterThread
+    *
+    * This function is the writer thread. It wakes up every flush interval or for a compaction,
+    * writes the pending records in one batch and flushes them to disk.
+    *
+    * \return void
+    */
+    static void WriterThread(void)
+    {
+        std::vector<Record_t> batch;
+        std::vector<Record_t> snapshot;
+        std::unique_lock<std::mutex> lock(Journal_Mutex);
+        bool isStopped = false;
+
+        while (false == isStopped)
+        {
+            bool isSnapshot;
+            size_t bufferBytes;
+
+            Journal_Signal.wait_for(lock, Journal_FlushInterval, [] { return (Journal_IsStopRequested || Journal_IsSnapshotPending); });
+
+            batch.swap(Journal_Pending);
+            snapshot.swap(Journal_Snapshot);
+            isSnapshot = Journal_IsSnapshotPending;
+            isStopped = Journal_IsStopRequested;
+            Journal_IsSnapshotPending = false;
+            bufferBytes = Memory::GetVectorBytes(batch) + Memory::GetVectorBytes(snapshot) +
+                Memory::GetVectorBytes(Journal_Pending) + Memory::GetVectorBytes(Journal_Snapshot);
+
+            lock.unlock();
+
+            /* the taken buffers are not seen by a sample while they are written, the registry is updated without the journal lock */
+            Memory::UpdatePeak("journal.buffers", bufferBytes);
+
+            /* the snapshot contains all records that were pending when it was taken, so it is written first */
+            if ((true == isSnapshot) && (false == WriteSnapshot(snapshot)))
+            {
+                /* the snapshot records carry the complete state, so they keep the journal consistent as well */
+                WriteRecords(Journal_File, snapshot);
+                SyncFile(Journal_File);
+            }
+
+            if (false == batch.empty())
+            {
+                WriteRecords(Journal_File, batch);
+                SyncFile(Journal_File);
+            }
+
+            batch.clear();
+            snapshot.clear();
+
+            lock.lock();
+        }
+    }
+
+
+    /**
+    * \brief GetBufferMemory
+    *
+    * \return size_t the bytes held by the buffers of the records and the snapshot
+    */
+    static size_t GetBufferMemory(void)
+    {
+        std::lock_guard<std::mutex> lock(Journal_Mutex);
+
+        return Memory::GetVectorBytes(Journal_Pending) + Memory::GetVectorBytes(Journal_Snapshot);
+    }
+
+
+    /* ===================================== [definition of global functions] ===================================== */
+
+
+    /**
+    * \brief Crc32
+    *
+    * This function calculates the CRC32 of a memory block
+    *
+    * \param[in] Data the memory block
+    * \param[in] Size the size of the memory block in bytes
+    * \return uint32_t the CRC32
+    */
+    uint32_t Crc32(const void* Data, size_t Size)
+    {
+        const uint8_t* data = static_cast<const uint8_t*>(Data);
+        uint32_t crc = 0xFFFFFFFFu;
+
+        for (size_t index = 0; index < Size; index++)
+        {
+            crc = Journal_CrcTable[(crc ^ data[index]) & 0xFFu] ^ (crc >> 8);
+        }
+
+        return ~crc;
+    }
+
+
+    /**
+    * \brief Open
+    *
+    * This function replays the snapshot and the journal in one sequential pass and starts the writer thread.
+    * The flush interval and the compaction limit are taken over at open, the flush interval is kept above zero.
+    *
+    * \param[in] Config the journal configuration
+    * \param[in] Replay the callback for every replayed record
+    * \return bool: true if the journal is opened, otherwise false
+    */
+    bool Open(const Util::JournalConfig_t& Config, const std::function<void(const Record_t&)>& Replay)
+    {
+        if ((false == Journal_IsOpen) && (true == Config.Enabled))
+        {
+            uint32_t snapshotCount = 0;
+            uint32_t journalCount = 0;
+            uint64_t snapshotGeneration;
+            uint64_t journalGeneration;
+            bool isJournalValid;
+
+            Memory::Register("journal.buffers", &GetBufferMemory);
+
+            Journal_Path = Util::GetPluginDirectory() + "CuddlePlugin.journal";
+            Journal_SnapshotPath = Util::GetPluginDirectory() + "CuddlePlugin.snapshot";
+            Journal_CompactionRecords = Config.CompactionRecords;
+            Journal_FlushInterval = std::max(std::chrono::milliseconds(static_cast<long long>(Config.FlushIntervalTime * 1000.0f)), JOURNAL_MIN_FLUSH_INTERVAL);
+
+            ReplayFile(Journal_SnapshotPath, SNAPSHOT_MAGIC, 0u, Replay, &snapshotCount, &snapshotGeneration);
+            isJournalValid = ReplayFile(Journal_Path, JOURNAL_MAGIC, snapshotGeneration, Replay, &journalCount, &journalGeneration);
+            Journal_Generation = std::max(snapshotGeneration, journalGeneration);
+
+            Log::GetLog()->info("replayed {} snapshot and {} journal records of generation {}", snapshotCount, journalCount, Journal_Generation);
+
+            /* an outdated journal is already contained in the snapshot and is discarded */
+            Journal_File = CreateJournalFile(Journal_Path, (journalGeneration < snapshotGeneration) ? "wb" : "ab", JOURNAL_MAGIC, Journal_Generation);
+
+            if (nullptr != Journal_File)
+            {
+                /* a torn or missing journal is compacted right away, so no record gets appended behind garbage */
+                Journal_RecordCount = (true == isJournalValid) ? journalCount : Journal_CompactionRecords;
+                Journal_IsStopRequested = false;
+                Journal_IsSnapshotPending = false;
+                Journal_IsOpen = true;
+                Journal_Writer = std::thread(&WriterThread);
+            }
+        }
+
+        return Journal_IsOpen;
+    }
+
+
+    /**
+    * \brief Append
+    *
+    * This function queues a record for the writer thread
+    *
+    * \param[in] Record the record
+    * \return void
+    */
+    void Append(const Record_t& Record)
+    {
+        if (true == Journal_IsOpen)
+        {
+            std::lock_guard<std::mutex> lock(Journal_Mutex);
+            Journal_Pending.push_back(Record);
+
+            Journal_RecordCount++;
+        }
+    }
+
+
+    /**
+    * \brief IsCompactionDue
+    *
+    * \return bool: true if the journal should be compacted into a snapshot, otherwise false
+    */
+    bool IsCompactionDue(void)
+    {
+        return ((true == Journal_IsOpen) && (Journal_RecordCount >= Journal_CompactionRecords));
+    }
+
+
+    /**
+    * \brief Compact
+    *
+    * This function hands a snapshot of the complete schedule to the writer thread. All pending records
+    * are part of the snapshot and are dropped.
+    *
+    * \param[in] Snapshot the records of the snapshot
+    * \return void
+    */
+    void Compact(std::vector<Record_t> Snapshot)
+    {
+        if (true == Journal_IsOpen)
+        {
+            {
+                std::lock_guard<std::mutex> lock(Journal_Mutex);
+                Journal_Snapshot = std::move(Snapshot);
+                Journal_Pending.clear();
+                Journal_IsSnapshotPending = true;
+            }
+            Journal_Signal.notify_one();
+
+            Journal_RecordCount = 0;
+        }
+    }
+
+
+    /**
+    * \brief Close
+    *
+    * This function writes all pending records, stops the writer thread and closes the journal
+    *
+    * \return void
+    */
+    void Close(void)
+    {
+        if (true == Journal_IsOpen)
+        {
+            {
+                std::lock_guard<std::mutex> lock(Journal_Mutex);
+                Journal_IsStopRequested = true;
+            }
+            Journal_Signal.notify_one();
+
+            if (true == Journal_Writer.joinable())
+            {
+                Journal_Writer.join();
+            }
+
+            if (nullptr != Journal_File)
+            {
+                fclose(Journal_File);
+                Journal_File = nullptr;
+            }
+
+            Journal_IsOpen = false;
+        }
+    }
+
+
+    /**
+    * \brief Abandon
+    *
+    * This function gives up a journal that was not closed, when the process exits without Plugin_Unload.
+    * It is called under the loader lock, where the writer thread may already be terminated while holding
+    * the mutex, so it neither locks nor joins. The writer thread is only detached, the records that were
+    * not yet flushed are lost and the journal is replayed up to the last flush at the next start.
+    *
+    * \return void
+    */
+    void Abandon(void)
+    {
+        if (true == Journal_IsOpen)
+        {
+            if (true == Journal_Writer.joinable())
+            {
+                /* a joinable thread would call std::terminate in its destructor */
+                Journal_Writer.detach();
+            }
+
+            Journal_IsOpen = false;
+        }
+    }
+}
+
+
+/* =================================================[end of file]================================================= */
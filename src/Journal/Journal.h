@@ -0,0 +1,90 @@
+/*****************************************************************************************************************
+* Copyright (C) 2019 by Matthias Birnthaler                                                                      *
+*                                                                                                                *
+* This file is part of the Cuddle Plugin for Ark Server API                                                      *
+*                                                                                                                *
+*    This program is free software : you can redistribute it and/or modify                                       *
+*    it under the terms of the GNU General Public License as published by                                        *
+*    the Free Software Foundation, either version 3 of the License, or                                           *
+*    (at your option) any later version.                                                                         *
+*                                                                                                                *
+*    This program is distributed in the hope that it will be useful,                                             *
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of                                              *
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the                                                 *
+*    GNU General Public License for more details.                                                                *
+*                                                                                                                *
+*    You should have received a copy of the GNU General Public License                                           *
+*    along with this program.If not, see <https://www.gnu.org/licenses/>.                                        *
+*                                                                                                                *
+*****************************************************************************************************************/
+
+/**
+* \file Journal.h
+* \author Matthias Birnthaler Matthias-Birnthaler@outlook.com
+* \date 18 October 2026
+* \brief Implementation of the crash safe imprint journal
+*
+*/
+
+
+#ifndef JOURNAL_H
+#define JOURNAL_H
+
+/* ================================================[includes]================================================ */
+
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <vector>
+#include "Util.h"
+
+
+namespace Journal {
+
+    /* ============================================ [type definitions] ============================================ */
+
+    /** \brief kind of a journal record */
+    enum RecordType_t : uint32_t {
+        /** \brief the next cuddle of the dino has been scheduled */
+        RECORD_SCHEDULED = 1,
+        /** \brief the imprinting quality of the dino has been increased */
+        RECORD_IMPRINTED = 2,
+        /** \brief the dino is no longer managed by the plugin */
+        RECORD_RELEASED = 3,
+        /** \brief the complete state of the dino as written by the compaction */
+        RECORD_SNAPSHOT = 4
+    };
+
+    /** \brief record of the journal, every record carries the complete state of the dino after the event */
+    struct Record_t {
+        /** \brief unique id of the dino */
+        uint64_t DinoId;
+        /** \brief server time of the event in secounds */
+        double Time;
+        /** \brief server time of the next cuddle in secounds */
+        double NextCuddleTime;
+        /** \brief the imprint increase of the event in floating point representation */
+        float Amount;
+        /** \brief the imprinting quality after the event in floating point representation */
+        float ImprintingQuality;
+        /** \brief the RecordType_t of the record */
+        uint32_t Type;
+        /** \brief CRC32 of all previous members, set by the journal */
+        uint32_t Checksum;
+    };
+
+    /* ================================================[declaration of public functions]========================= */
+
+    extern uint32_t Crc32(const void* Data, size_t Size);
+    extern bool Open(const Util::JournalConfig_t& Config, const std::function<void(const Record_t&)>& Replay);
+    extern void Append(const Record_t& Record);
+    extern bool IsCompactionDue(void);
+    extern void Compact(std::vector<Record_t> Snapshot);
+    extern void Close(void);
+    extern void Abandon(void);
+}
+
+
+#endif /* JOURNAL_H */
+
+/* =================================================[end of file]================================================= */
@@ -0,0 +1,164 @@
+/*****************************************************************************************************************
+* Copyright (C) 2019 by Matthias Birnthaler                                                                      *
+*                                                                                                                *
+* This file is part of the Cuddle Plugin for Ark Server API                                                      *
+*                                                                                                                *
+*    This program is free software : you can redistribute it and/or modify                                       *
+*    it under the terms of the GNU General Public License as published by                                        *
+*    the Free Software Foundation, either version 3 of the License, or                                           *
+*    (at your option) any later version.                                                                         *
+*                                                                                                                *
+*    This program is distributed in the hope that it will be useful,                                             *
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of                                              *
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the                                                 *
+*    GNU General Public License for more details.                                                                *
+*                                                                                                                *
+*    You should have received a copy of the GNU General Public License                                           *
+*    along with this program.If not, see <https://www.gnu.org/licenses/>.                                        *
+*                                                                                                                *
+*****************************************************************************************************************/
+
+/**
+* \file Lookup.h
+* \author Matthias Birnthaler Matthias-Birnthaler@outlook.com
+* \date 18 October 2026
+* \brief Hash, species table probe and blocked bloom filter over the name indices of the configured dino tags
+*
+* The filter has one cache line per block, a name index sets two bits in the block selected by its hash,
+* so a dino tag that is not configured is rejected with a single cache line read. The species table is
+* open addressed by the high bits of the hash and has at least twice as many slots as entries. The kernel
+* has no dependency on the Ark Server API, so it is tested and benchmarked on the host.
+*/
+
+
+#ifndef LOOKUP_H
+#define LOOKUP_H
+
+/* ================================================[includes]================================================ */
+
+#include <cstdint>
+#include <cstring>
+
+
+namespace Lookup {
+
+    /* ============================================ [type definitions] ============================================ */
+
+    /** \brief number of 64 bit words of the filter (8 blocks of one cache line each) */
+    #define LOOKUP_FILTER_WORDS         64
+    /** \brief number of 64 bit words per filter block (one cache line) */
+    #define LOOKUP_FILTER_BLOCK_WORDS   8
+    /** \brief shift of the hash to the slot index of the smallest species table (8 slots) */
+    #define LOOKUP_TABLE_MAX_SHIFT      61u
+
+
+    /* ================================================[definition of inline functions]========================== */
+
+    /**
+    * \brief HashNameIndex
+    *
+    * This function scrambles a name index so that neighbouring indices spread over the whole filter
+    *
+    * \param[in] NameIndex the comparison index of a FName
+    * \return uint64_t the hash of the name index
+    */
+    inline uint64_t HashNameIndex(int NameIndex)
+    {
+        return static_cast<uint64_t>(static_cast<uint32_t>(NameIndex)) * 0x9E3779B97F4A7C15ull;
+    }
+
+
+    /**
+    * \brief GetTableShift
+    *
+    * \param[in] Count the number of entries of the species table
+    * \return uint32_t the shift of the hash to the slot index, the table has 1 << (64 - shift) slots
+    */
+    inline uint32_t GetTableShift(size_t Count)
+    {
+        uint32_t shift = LOOKUP_TABLE_MAX_SHIFT;
+
+        while ((1ull << (64u - shift)) < (2u * Count))
+        {
+            shift--;
+        }
+
+        return shift;
+    }
+
+
+    /**
+    * \brief ProbeTable
+    *
+    * This function probes the species table linearly from the slot of the hash
+    *
+    * \param[in] Slots the slots of the table, a slot with the name index 0 is empty
+    * \param[in] Shift the shift of the hash to the slot index
+    * \param[in] NameIndex the name index of a dino tag, not 0
+    * \return uint32_t the index of the slot of the name index, or of the empty slot it would be inserted to
+    */
+    template <class Slot>
+    inline uint32_t ProbeTable(const Slot* Slots, uint32_t Shift, int NameIndex)
+    {
+        const uint32_t mask = static_cast<uint32_t>((1ull << (64u - Shift)) - 1u);
+        uint32_t slot = static_cast<uint32_t>(HashNameIndex(NameIndex) >> Shift);
+
+        while ((0 != Slots[slot].NameIndex) && (NameIndex != Slots[slot].NameIndex))
+        {
+            slot = (slot + 1u) & mask;
+        }
+
+        return slot;
+    }
+
+
+    /**
+    * \brief ClearFilter
+    *
+    * \param[out] Filter the filter of LOOKUP_FILTER_WORDS words
+    * \return void
+    */
+    inline void ClearFilter(uint64_t* Filter)
+    {
+        memset(Filter, 0, LOOKUP_FILTER_WORDS * sizeof(uint64_t));
+    }
+
+
+    /**
+    * \brief AddToFilter
+    *
+    * \param[in,out] Filter the filter of LOOKUP_FILTER_WORDS words
+    * \param[in] NameIndex the name index of a configured dino tag
+    * \return void
+    */
+    inline void AddToFilter(uint64_t* Filter, int NameIndex)
+    {
+        const uint64_t hash = HashNameIndex(NameIndex);
+        uint64_t* block = &Filter[(hash >> 61) * LOOKUP_FILTER_BLOCK_WORDS];
+
+        block[(hash >> 58) & 7] |= (1ull << ((hash >> 52) & 63));
+        block[(hash >> 49) & 7] |= (1ull << ((hash >> 43) & 63));
+    }
+
+
+    /**
+    * \brief ProbeFilter
+    *
+    * \param[in] Filter the filter of LOOKUP_FILTER_WORDS words
+    * \param[in] NameIndex the name index of a dino tag
+    * \return bool: true if the dino tag may be configured, false if it is not configured
+    */
+    inline bool ProbeFilter(const uint64_t* Filter, int NameIndex)
+    {
+        const uint64_t hash = HashNameIndex(NameIndex);
+        const uint64_t* block = &Filter[(hash >> 61) * LOOKUP_FILTER_BLOCK_WORDS];
+
+        return ((0 != (block[(hash >> 58) & 7] & (1ull << ((hash >> 52) & 63)))) &&
+                (0 != (block[(hash >> 49) & 7] & (1ull << ((hash >> 43) & 63)))));
+    }
+}
+
+
+#endif /* LOOKUP_H */
+
+/* =================================================[end of file]================================================= */
@@ -0,0 +1,261 @@
+/*****************************************************************************************************************
+* Copyright (C) 2019 by Matthias Birnthaler                                                                      *
+*                                                                                                                *
+* This file is part of the Cuddle Plugin for Ark Server API                                                      *
+*                                                                                                                *
+*    This program is free software : you can redistribute it and/or modify                                       *
+*    it under the terms of the GNU General Public License as published by                                        *
+*    the Free Software Foundation, either version 3 of the License, or                                           *
+*    (at your option) any later version.                                                                         *
+*                                                                                                                *
+*    This program is distributed in the hope that it will be useful,                                             *
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of                                              *
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the                                                 *
+*    GNU General Public License for more details.                                                                *
+*                                                                                                                *
+*    You should have received a copy of the GNU General Public License                                           *
+*    along with this program.If not, see <https://www.gnu.org/licenses/>.                                        *
+*                                                                                                                *
+*****************************************************************************************************************/
+
+/**
+* \file Memory.cpp
+* \author Matthias Birnthaler Matthias-Birnthaler@outlook.com
+* \date 18 October 2026
+* \brief Registry of the memory footprint of the data structures of the plugin
+*
+*/
+
+/* ================================================ [includes] ================================================ */
+#include "Memory.h"
+
+#include "API/ARK/Ark.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+
+
+namespace Memory {
+
+    /* ============================================ [type definitions] ============================================ */
+    /** \brief maximum number of registered data structures */
+    #define MEMORY_MAX_ENTRIES      32u
+
+    /** \brief registered data structure */
+    struct Entry_t {
+        /** \brief the footprint */
+        Usage_t Usage;
+        /** \brief the reporter */
+        Reporter_t Reporter;
+    };
+
+    /* =============================================== [local data] =============================================== */
+
+    /** \brief the registered data structures */
+    static Entry_t Memory_Entries[MEMORY_MAX_ENTRIES];
+
+    /** \brief number of registered data structures */
+    static size_t Memory_EntryCount = 0u;
+
+    /** \brief protects the registry, the journal reports from its writer thread */
+    static std::mutex Memory_Mutex;
+
+
+    /* ===================================== [definition of global functions] ===================================== */
+
+
+    /**
+    * \brief Register
+    *
+    * This function registers the reporter of a data structure. A registered name keeps its peak and gets the new reporter.
+    *
+    * \param[in] Name the name of the data structure, a string literal
+    * \param[in] Reporter the reporter of the data structure
+    * \return void
+    */
+    void Register(const char* Name, Reporter_t Reporter)
+    {
+        std::lock_guard<std::mutex> lock(Memory_Mutex);
+
+        for (size_t index = 0u; index < Memory_EntryCount; index++)
+        {
+            if (0 == std::strcmp(Memory_Entries[index].Usage.Name, Name))
+            {
+                Memory_Entries[index].Reporter = Reporter;
+                return;
+            }
+        }
+
+        if (MEMORY_MAX_ENTRIES > Memory_EntryCount)
+        {
+            Memory_Entries[Memory_EntryCount] = { { Name, 0u, 0u }, Reporter };
+            Memory_EntryCount++;
+        }
+        else
+        {
+            Log::GetLog()->warn("memory report of {} not registered, the registry is limited to {} entries", Name, MEMORY_MAX_ENTRIES);
+        }
+    }
+
+
+    /**
+    * \brief Sample
+    *
+    * This function samples the live bytes of all registered data structures and updates their peak
+    *
+    * \return void
+    */
+    void Sample(void)
+    {
+        std::lock_guard<std::mutex> lock(Memory_Mutex);
+
+        for (size_t index = 0u; index < Memory_EntryCount; index++)
+        {
+            Usage_t& usage = Memory_Entries[index].Usage;
+
+            usage.Live = Memory_Entries[index].Reporter();
+            usage.Peak = (usage.Live > usage.Peak) ? usage.Live : usage.Peak;
+        }
+    }
+
+
+    /**
+    * \brief UpdatePeak
+    *
+    * This function raises the peak of a data structure to the bytes that are held at a point of mutation.
+    * The caller must not hold a lock that one of the reporters takes.
+    *
+    * \param[in] Name the name of the registered data structure
+    * \param[in] Bytes the bytes that are held at the moment
+    * \return void
+    */
+    void UpdatePeak(const char* Name, size_t Bytes)
+    {
+        std::lock_guard<std::mutex> lock(Memory_Mutex);
+
+        for (size_t index = 0u; index < Memory_EntryCount; index++)
+        {
+            Usage_t& usage = Memory_Entries[index].Usage;
+
+            if (0 == std::strcmp(usage.Name, Name))
+            {
+                usage.Peak = (Bytes > usage.Peak) ? Bytes : usage.Peak;
+                break;
+            }
+        }
+    }
+
+
+    /**
+    * \brief GetUsageCount
+    *
+    * \return size_t the number of registered data structures
+    */
+    size_t GetUsageCount(void)
+    {
+        std::lock_guard<std::mutex> lock(Memory_Mutex);
+
+        return Memory_EntryCount;
+    }
+
+
+    /**
+    * \brief GetUsage
+    *
+    * \param[in] Index the index of the data structure
+    * \return Usage_t the footprint of the last sample
+    */
+    Usage_t GetUsage(size_t Index)
+    {
+        std::lock_guard<std::mutex> lock(Memory_Mutex);
+
+        return (Index < Memory_EntryCount) ? Memory_Entries[Index].Usage : Usage_t{ "", 0u, 0u };
+    }
+
+
+    /**
+    * \brief GetTotal
+    *
+    * \param[out] Live the sum of the live bytes of the last sample
+    * \param[out] Peak the sum of the peak bytes
+    * \return void
+    */
+    void GetTotal(size_t* Live, size_t* Peak)
+    {
+        std::lock_guard<std::mutex> lock(Memory_Mutex);
+
+        *Live = 0u;
+        *Peak = 0u;
+
+        for (size_t index = 0u; index < Memory_EntryCount; index++)
+        {
+            *Live += Memory_Entries[index].Usage.Live;
+            *Peak += Memory_Entries[index].Usage.Peak;
+        }
+    }
+
+
+    /**
+    * \brief CreateArena
+    *
+    * This function allocates the memory block of an arena. The block is aligned for every fundamental type.
+    *
+    * \param[out] Arena the arena
+    * \param[in] Capacity the size of the memory block in bytes
+    * \return bool: true if the memory block could be allocated, otherwise false
+    */
+    bool CreateArena(Arena_t* Arena, size_t Capacity)
+    {
+        Arena->Base = static_cast<uint8_t*>(std::malloc((0u < Capacity) ? Capacity : 1u));
+        Arena->Capacity = (nullptr != Arena->Base) ? Capacity : 0u;
+        Arena->Used = 0u;
+
+        return (nullptr != Arena->Base);
+    }
+
+
+    /**
+    * \brief Allocate
+    *
+    * This function carves an allocation from the arena, there is no release of single allocations
+    *
+    * \param[in,out] Arena the arena
+    * \param[in] Size the size of the allocation in bytes
+    * \param[in] Alignment the alignment of the allocation, a power of two up to alignof(std::max_align_t)
+    * \return void* the allocation, nullptr if the arena is exhausted
+    */
+    void* Allocate(Arena_t* Arena, size_t Size, size_t Alignment)
+    {
+        void* result = nullptr;
+        const size_t end = Reserve(Arena->Used, Size, Alignment);
+
+        if ((nullptr != Arena->Base) && (end <= Arena->Capacity))
+        {
+            result = Arena->Base + (end - Size);
+            Arena->Used = end;
+        }
+
+        return result;
+    }
+
+
+    /**
+    * \brief DestroyArena
+    *
+    * This function releases the memory block and with it all allocations of the arena
+    *
+    * \param[in,out] Arena the arena
+    * \return void
+    */
+    void DestroyArena(Arena_t* Arena)
+    {
+        std::free(Arena->Base);
+
+        Arena->Base = nullptr;
+        Arena->Capacity = 0u;
+        Arena->Used = 0u;
+    }
+}
+
+/* =================================================[end of file]================================================= */
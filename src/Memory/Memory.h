@@ -0,0 +1,172 @@
+/*****************************************************************************************************************
+* Copyright (C) 2019 by Matthias Birnthaler                                                                      *
+*                                                                                                                *
+* This file is part of the Cuddle Plugin for Ark Server API                                                      *
+*                                                                                                                *
+*    This program is free software : you can redistribute it and/or modify                                       *
+*    it under the terms of the GNU General Public License as published by                                        *
+*    the Free Software Foundation, either version 3 of the License, or                                           *
+*    (at your option) any later version.                                                                         *
+*                                                                                                                *
+*    This program is distributed in the hope that it will be useful,                                             *
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of                                              *
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the                                                 *
+*    GNU General Public License for more details.                                                                *
+*                                                                                                                *
+*    You should have received a copy of the GNU General Public License                                           *
+*    along with this program.If not, see <https://www.gnu.org/licenses/>.                                        *
+*                                                                                                                *
+*****************************************************************************************************************/
+
+/**
+* \file Memory.h
+* \author Matthias Birnthaler Matthias-Birnthaler@outlook.com
+* \date 18 October 2026
+* \brief Registry of the memory footprint of the data structures of the plugin
+*
+* Every module registers a reporter per data structure, that returns the bytes the structure holds.
+* The reporters are sampled on demand (commands, reload, compaction), the peak is the highest sample.
+* Transient footprints that no sample can see, like two generations of a table that are alive at the same
+* time, are reported by the modules at their mutation points with UpdatePeak.
+*/
+
+
+#ifndef MEMORY_H
+#define MEMORY_H
+
+/* ================================================[includes]================================================ */
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+
+namespace Memory {
+
+    /* ============================================ [type definitions] ============================================ */
+
+    /** \brief reporter of a data structure, returns the bytes that are held by the structure */
+    typedef size_t(*Reporter_t)(void);
+
+    /** \brief footprint of a registered data structure */
+    struct Usage_t {
+        /** \brief name of the data structure */
+        const char* Name;
+        /** \brief bytes of the last sample */
+        size_t Live;
+        /** \brief highest sampled or reported bytes */
+        size_t Peak;
+    };
+
+    /** \brief monotonic arena, the allocations are released together by DestroyArena */
+    struct Arena_t {
+        /** \brief begin of the memory block, nullptr if the arena is not created */
+        uint8_t* Base;
+        /** \brief size of the memory block in bytes */
+        size_t Capacity;
+        /** \brief allocated bytes */
+        size_t Used;
+    };
+
+    /* ================================================[declaration of public functions]========================= */
+
+    extern void Register(const char* Name, Reporter_t Reporter);
+    extern void Sample(void);
+    extern void UpdatePeak(const char* Name, size_t Bytes);
+    extern size_t GetUsageCount(void);
+    extern Usage_t GetUsage(size_t Index);
+    extern void GetTotal(size_t* Live, size_t* Peak);
+    extern bool CreateArena(Arena_t* Arena, size_t Capacity);
+    extern void* Allocate(Arena_t* Arena, size_t Size, size_t Alignment);
+    extern void DestroyArena(Arena_t* Arena);
+
+
+    /* ================================================[definition of inline functions]========================== */
+
+    /**
+    * \brief GetStringBytes
+    *
+    * \param[in] Text a string
+    * \return size_t the bytes allocated by the string, 0 if the string fits into the small string buffer
+    */
+    template <class String>
+    inline size_t GetStringBytes(const String& Text)
+    {
+        return (Text.capacity() > String().capacity()) ? ((Text.capacity() + 1u) * sizeof(typename String::value_type)) : 0u;
+    }
+
+
+    /**
+    * \brief GetVectorBytes
+    *
+    * \param[in] Elements a vector
+    * \return size_t the bytes allocated by the vector, without memory allocated by the elements
+    */
+    template <class Vector>
+    inline size_t GetVectorBytes(const Vector& Elements)
+    {
+        return Elements.capacity() * sizeof(typename Vector::value_type);
+    }
+
+
+    /**
+    * \brief GetTreeBytes
+    *
+    * \param[in] Nodes a std::map or std::set
+    * \return size_t the estimated bytes of the nodes (value, three links and the color)
+    */
+    template <class Tree>
+    inline size_t GetTreeBytes(const Tree& Nodes)
+    {
+        return Nodes.size() * (sizeof(typename Tree::value_type) + (4u * sizeof(void*)));
+    }
+
+
+    /**
+    * \brief GetHashBytes
+    *
+    * \param[in] Nodes a std::unordered_map or std::unordered_set
+    * \return size_t the estimated bytes of the nodes (value, two links) and the buckets
+    */
+    template <class Hash>
+    inline size_t GetHashBytes(const Hash& Nodes)
+    {
+        return (Nodes.size() * (sizeof(typename Hash::value_type) + (2u * sizeof(void*)))) + (Nodes.bucket_count() * 2u * sizeof(void*));
+    }
+
+
+    /**
+    * \brief Reserve
+    *
+    * This function measures an allocation of an arena, so the capacity can be determined before the arena is created
+    *
+    * \param[in] Offset the bytes reserved so far
+    * \param[in] Size the size of the allocation in bytes
+    * \param[in] Alignment the alignment of the allocation, a power of two
+    * \return size_t the bytes reserved including the allocation
+    */
+    inline size_t Reserve(size_t Offset, size_t Size, size_t Alignment)
+    {
+        return ((Offset + (Alignment - 1u)) & ~(Alignment - 1u)) + Size;
+    }
+
+
+    /**
+    * \brief AllocateArray
+    *
+    * \param[in] Arena the arena
+    * \param[in] Count the number of elements
+    * \return T* the uninitialised elements, nullptr if the arena is exhausted
+    */
+    template <class T>
+    inline T* AllocateArray(Arena_t* Arena, size_t Count)
+    {
+        return static_cast<T*>(Allocate(Arena, Count * sizeof(T), alignof(T)));
+    }
+}
+
+
+#endif /* MEMORY_H */
+
+/* =================================================[end of file]================================================= */
@@ -0,0 +1,441 @@
+/*****************************************************************************************************************
+* Copyright (C) 2019 by Matthias Birnthaler                                                                      *
+*                                                                                                                *
+* This file is part of the Cuddle Plugin for Ark Server API                                                      *
+*                                                                                                                *
+*    This program is free software : you can redistribute it and/or modify                                       *
+*    it under the terms of the GNU General Public License as published by                                        *
+*    the Free Software Foundation, either version 3 of the License, or                                           *
+*    (at your option) any later version.                                                                         *
+*                                                                                                                *
+*    This program is distributed in the hope that it will be useful,                                             *
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of                                              *
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the                                                 *
+*    GNU General Public License for more details.                                                                *
+*                                                                                                                *
+*    You should have received a copy of the GNU General Public License                                           *
+*    along with this program.If not, see <https://www.gnu.org/licenses/>.                                        *
+*                                                                                                                *
+*****************************************************************************************************************/
+
+/**
+* \file Scheduler.cpp
+* \author Matthias Birnthaler Matthias-Birnthaler@outlook.com
+* \date 18 October 2026
+* \brief Implementation of the automatic imprint of dinos of offline tribes
+*
+* Dinos of species with AutoImprint are queued by their next cuddle time. Every server tick the due dinos
+* are imprinted through the regular imprint functions of the dino, as long as the work budget of the tick
+* (number of dinos and time) is not used up. The remaining due dinos are left for the next ticks.
+* Bulk imprints of admin commands are processed first, in batches within the same work budget. A batch is
+* evaluated at once by the SIMD batch evaluation of the imprint kernel.
+*/
+
+/* ================================================ [includes] ================================================ */
+#include "Scheduler.h"
+#include "Tracker.h"
+#include "Util.h"
+#include "Imprint.h"
+#include "Hooks.h"
+#include "Memory.h"
+
+#include "API/ARK/Ark.h"
+
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <queue>
+#include <vector>
+
+
+namespace Scheduler {
+
+    /* ============================================ [type definitions] ============================================ */
+
+    /** \brief queued cuddle of a dino */
+    struct Entry_t {
+        /** \brief server time when the dino is processed in secounds */
+        double DueTime;
+        /** \brief the next cuddle time of the dino when it was queued, outdated entries are dropped */
+        double NextCuddleTime;
+        /** \brief unique id of the dino */
+        uint64_t DinoId;
+    };
+
+    /** \brief maximum number of dinos of a bulk imprint batch */
+    #define SCHEDULER_BULK_BATCH_SIZE   32u
+
+    /** \brief queued bulk imprint of a dino */
+    struct BulkEntry_t {
+        /** \brief unique id of the dino */
+        uint64_t DinoId;
+        /** \brief the imprint increase in floating point representation */
+        float Increase;
+    };
+
+    /** \brief work budget of a tick */
+    struct Budget_t {
+        /** \brief start of the tick */
+        std::chrono::steady_clock::time_point Start;
+        /** \brief maximum time of the tick */
+        std::chrono::microseconds MaxTime;
+        /** \brief number of processed dinos */
+        uint32_t Dinos;
+        /** \brief maximum number of processed dinos */
+        uint32_t MaxDinos;
+    };
+
+    /** \brief orders the queue by the earliest due time */
+    struct Later_t {
+        bool operator()(const Entry_t& A, const Entry_t& B) const
+        {
+            return (A.DueTime > B.DueTime);
+        }
+    };
+
+    /* =============================================== [local data] =============================================== */
+
+    /** \brief the queued cuddles, the earliest due time on top */
+    static std::priority_queue<Entry_t, std::vector<Entry_t>, Later_t> Scheduler_Queue;
+
+    /** \brief the queued bulk imprints in the order of the requests */
+    static std::deque<BulkEntry_t> Scheduler_Bulk;
+
+    /** \brief sorted team ids of the online players, collected once per tick with due dinos */
+    static std::vector<int> Scheduler_OnlineTeams;
+
+    /* ===================================== [prototype of local functions] ======================================= */
+
+    static void Tick(float DeltaSeconds);
+    static void CollectOnlineTeams(UWorld* World);
+    static bool IsTeamOnline(int TeamId);
+    static bool IsBudgetLeft(const Budget_t& Budget);
+    static void ProcessBulk(double Time, Budget_t* Budget);
+    static void ProcessQueue(UWorld* World, double Time, Budget_t* Budget);
+    static size_t GetQueueMemory(void);
+    static void ImprintDino(APrimalDinoCharacter* Dino, const Util::CuddleData_t& CuddleData, double Time);
+
+
+    /**
+    * \brief CollectOnlineTeams
+    *
+    * This function collects the team ids of all online players
+    *
+    * \param[in] World the world
+    * \return void
+    */
+    static void CollectOnlineTeams(UWorld* World)
+    {
+        Scheduler_OnlineTeams.clear();
+
+        for (TWeakObjectPtr<APlayerController> controller : World->PlayerControllerListField())
+        {
+            APlayerController* player = controller.Get();
+
+            if (nullptr != player)
+            {
+                Scheduler_OnlineTeams.push_back(player->TargetingTeamField());
+            }
+        }
+
+        std::sort(Scheduler_OnlineTeams.begin(), Scheduler_OnlineTeams.end());
+    }
+
+
+    /**
+    * \brief IsTeamOnline
+    *
+    * \param[in] TeamId the team id of a tribe or a solo player
+    * \return bool: true if a player of the team is online, otherwise false
+    */
+    static bool IsTeamOnline(int TeamId)
+    {
+        return std::binary_search(Scheduler_OnlineTeams.begin(), Scheduler_OnlineTeams.end(), TeamId);
+    }
+
+
+    /**
+    * \brief ImprintDino
+    *
+    * This function applies one cuddle to the dino through the same functions the game uses,
+    * so the hooks of the plugin apply the configured increase and schedule the next cuddle.
+    *
+    * \param[in] Dino the dino
+    * \param[in] CuddleData the cuddle data of the dino
+    * \param[in] Time the current server time in secounds
+    * \return void
+    */
+    static void ImprintDino(APrimalDinoCharacter* Dino, const Util::CuddleData_t& CuddleData, double Time)
+    {
+        const float imprintingQuality = Dino->MyCharacterStatusComponentField()->DinoImprintingQualityField();
+
+        Dino->AddedImprintingQuality(Imprint::GetAddedAmount(imprintingQuality, CuddleData.CuddleIncreasePercent));
+        Dino->UpdateImprintingQuality(Imprint::AddQuality(imprintingQuality, CuddleData.CuddleIncreasePercent));
+        Dino->UpdateBabyCuddling(Time + CuddleData.CuddleIntervalTime, static_cast<char>(Dino->BabyCuddleTypeField()), Dino->BabyCuddleFoodField());
+    }
+
+
+    /**
+    * \brief IsBudgetLeft
+    *
+    * \param[in] Budget the work budget of the tick
+    * \return bool: true if another dino can be processed in this tick, otherwise false
+    */
+    static bool IsBudgetLeft(const Budget_t& Budget)
+    {
+        return (Budget.Dinos < Budget.MaxDinos) && ((std::chrono::steady_clock::now() - Budget.Start) < Budget.MaxTime);
+    }
+
+
+    /**
+    * \brief ProcessBulk
+    *
+    * This function applies the queued bulk imprints in batches through the batch evaluation of the imprint kernel.
+    * The imprinting quality is set through the original game function, so the configured increase per cuddle is
+    * not applied. Configured dinos get their next cuddle after the configured interval, or after the maturation
+    * time once fully imprinted, through the game function, so the hooks pick the cuddle type and align the time.
+    * The next cuddle of dinos that are not configured is kept.
+    *
+    * \param[in] Time the current server time in secounds
+    * \param[in,out] Budget the work budget of the tick
+    * \return void
+    */
+    static void ProcessBulk(double Time, Budget_t* Budget)
+    {
+        APrimalDinoCharacter* dinos[SCHEDULER_BULK_BATCH_SIZE];
+        bool isConfigured[SCHEDULER_BULK_BATCH_SIZE];
+        float previous[SCHEDULER_BULK_BATCH_SIZE];
+        float quality[SCHEDULER_BULK_BATCH_SIZE];
+        float increase[SCHEDULER_BULK_BATCH_SIZE];
+        float interval[SCHEDULER_BULK_BATCH_SIZE];
+        float maturationTime[SCHEDULER_BULK_BATCH_SIZE];
+        double deadline[SCHEDULER_BULK_BATCH_SIZE];
+
+        while ((false == Scheduler_Bulk.empty()) && (true == IsBudgetLeft(*Budget)))
+        {
+            size_t count = 0;
+
+            while ((false == Scheduler_Bulk.empty()) && (count < SCHEDULER_BULK_BATCH_SIZE) && (Budget->Dinos < Budget->MaxDinos))
+            {
+                const BulkEntry_t entry = Scheduler_Bulk.front();
+                const Tracker::DinoState_t* state = Tracker::FindDino(entry.DinoId);
+                Util::CuddleData_t cuddledata;
+
+                Scheduler_Bulk.pop_front();
+
+                /* released or despawned dinos are dropped */
+                if ((nullptr != state) && (nullptr != state->Dino) && (nullptr != state->Dino->MyCharacterStatusComponentField()))
+                {
+                    APrimalDinoCharacter* dino = state->Dino;
+
+                    dinos[count] = dino;
+                    isConfigured[count] = Util::GetDinoCuddleData(dino, &cuddledata);
+                    previous[count] = dino->MyCharacterStatusComponentField()->DinoImprintingQualityField();
+                    quality[count] = previous[count];
+                    increase[count] = entry.Increase;
+                    interval[count] = (true == isConfigured[count]) ? cuddledata.CuddleIntervalTime : 0.0f;
+                    maturationTime[count] = dino->BabyImprintingQualityTotalMaturationTimeField();
+                    count++;
+                    Budget->Dinos++;
+                }
+            }
+
+            Imprint::EvaluateBatch({ quality, increase, interval, maturationTime, deadline, count }, Time);
+
+            for (size_t index = 0; index < count; index++)
+            {
+                APrimalDinoCharacter* dino = dinos[index];
+
+                APrimalDinoCharacter_UpdateImprintingQuality_original(dino, quality[index]);
+                Tracker::OnImprinted(dino, Time, quality[index] - Imprint::ClampQuality(previous[index]));
+
+                if (true == isConfigured[index])
+                {
+                    dino->UpdateBabyCuddling(deadline[index], static_cast<char>(dino->BabyCuddleTypeField()), dino->BabyCuddleFoodField());
+                }
+            }
+        }
+    }
+
+
+    /**
+    * \brief ProcessQueue
+    *
+    * This function imprints the due dinos of offline tribes. Due dinos of online tribes are checked again later.
+    *
+    * \param[in] World the world
+    * \param[in] Time the current server time in secounds
+    * \param[in,out] Budget the work budget of the tick
+    * \return void
+    */
+    static void ProcessQueue(UWorld* World, double Time, Budget_t* Budget)
+    {
+        if ((false == Scheduler_Queue.empty()) && (Scheduler_Queue.top().DueTime <= Time) &&
+            (true == Util::IsFeatureEnabled(Util::FEATURE_AUTOIMPRINT)))
+        {
+            CollectOnlineTeams(World);
+
+            while ((false == Scheduler_Queue.empty()) && (Scheduler_Queue.top().DueTime <= Time) && (true == IsBudgetLeft(*Budget)))
+            {
+                const Entry_t entry = Scheduler_Queue.top();
+                const Tracker::DinoState_t* state = Tracker::FindDino(entry.DinoId);
+                Util::CuddleData_t cuddledata;
+
+                Scheduler_Queue.pop();
+
+                /* outdated entries (the dino got cuddled, released or despawned meanwhile) are dropped */
+                if ((nullptr != state) && (nullptr != state->Dino) && (state->NextCuddleTime == entry.NextCuddleTime) &&
+                    (nullptr != state->Dino->MyCharacterStatusComponentField()))
+                {
+                    APrimalDinoCharacter* dino = state->Dino;
+
+                    Budget->Dinos++;
+
+                    if ((true == Util::GetDinoCuddleData(dino, &cuddledata)) && (true == cuddledata.AutoImprint))
+                    {
+                        if (true == IsTeamOnline(dino->TargetingTeamField()))
+                        {
+                            Scheduler_Queue.push({ Time + Util::GetAutoImprintConfig().OnlineRetryTime, entry.NextCuddleTime, entry.DinoId });
+                        }
+                        else
+                        {
+                            ImprintDino(dino, cuddledata, Time);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+
+    /**
+    * \brief GetQueueMemory
+    *
+    * \return size_t the estimated bytes held by the queues of the scheduler
+    */
+    static size_t GetQueueMemory(void)
+    {
+        return (Scheduler_Queue.size() * sizeof(Entry_t)) + (Scheduler_Bulk.size() * sizeof(BulkEntry_t)) +
+            Memory::GetVectorBytes(Scheduler_OnlineTeams);
+    }
+
+
+    /**
+    * \brief Tick
+    *
+    * This function retries the blueprints of the config that could not be loaded yet, refreshes a part of the
+    * spatial grid and processes the bulk imprints and the due dinos within the work budget of the tick
+    *
+    * \param[in] DeltaSeconds the time since the last tick, not used
+    * \return void
+    */
+    static void Tick(float DeltaSeconds)
+    {
+        UWorld* world = ArkApi::GetApiUtils().GetWorld();
+
+        Util::ResolvePendingClasses();
+        Tracker::RefreshGrid();
+
+        if ((nullptr != world) && ((false == Scheduler_Bulk.empty()) || (false == Scheduler_Queue.empty())))
+        {
+            const Util::AutoImprintConfig_t& config = Util::GetAutoImprintConfig();
+            const double time = static_cast<double>(world->TimeSecondsField());
+            Budget_t budget = { std::chrono::steady_clock::now(), std::chrono::microseconds(config.MaxTickTime), 0u, config.MaxDinosPerTick };
+
+            ProcessBulk(time, &budget);
+            ProcessQueue(world, time, &budget);
+        }
+    }
+
+
+    /* ===================================== [definition of global functions] ===================================== */
+
+
+    /**
+    * \brief Init
+    *
+    * This function registers the scheduler at the server tick
+    *
+    * \return void
+    */
+    void Init(void)
+    {
+        ArkApi::GetCommands().AddOnTickCallback("CuddlePlugin.AutoImprint", &Tick);
+
+        Memory::Register("scheduler.queues", &GetQueueMemory);
+    }
+
+
+    /**
+    * \brief Shutdown
+    *
+    * This function removes the scheduler from the server tick and drops the queue
+    *
+    * \return void
+    */
+    void Shutdown(void)
+    {
+        ArkApi::GetCommands().RemoveOnTickCallback("CuddlePlugin.AutoImprint");
+
+        Scheduler_Queue = decltype(Scheduler_Queue)();
+        Scheduler_Bulk.clear();
+    }
+
+
+    /**
+    * \brief Schedule
+    *
+    * This function queues the next cuddle of a dino with automatic imprint
+    *
+    * \param[in] DinoId the id of the dino
+    * \param[in] NextCuddleTime the server time of the next cuddle in secounds
+    * \return void
+    */
+    void Schedule(uint64_t DinoId, double NextCuddleTime)
+    {
+        Scheduler_Queue.push({ NextCuddleTime, NextCuddleTime, DinoId });
+    }
+
+
+    /**
+    * \brief QueueImprint
+    *
+    * This function queues a bulk imprint of dinos, it is applied over the next ticks within the work budget
+    *
+    * \param[in] DinoIds the ids of the dinos
+    * \param[in] Increase the imprint increase in floating point representation
+    * \return void
+    */
+    void QueueImprint(const std::vector<uint64_t>& DinoIds, float Increase)
+    {
+        for (const uint64_t dinoId : DinoIds)
+        {
+            Scheduler_Bulk.push_back({ dinoId, Increase });
+        }
+    }
+
+
+    /**
+    * \brief GetBulkPendingCount
+    *
+    * \return size_t the number of queued bulk imprints
+    */
+    size_t GetBulkPendingCount(void)
+    {
+        return Scheduler_Bulk.size();
+    }
+
+
+    /**
+    * \brief GetPendingCount
+    *
+    * \return size_t the number of queued cuddles including outdated ones
+    */
+    size_t GetPendingCount(void)
+    {
+        return Scheduler_Queue.size();
+    }
+}
+
+
+/* =================================================[end of file]================================================= */
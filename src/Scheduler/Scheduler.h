@@ -0,0 +1,55 @@
+/*****************************************************************************************************************
+* Copyright (C) 2019 by Matthias Birnthaler                                                                      *
+*                                                                                                                *
+* This file is part of the Cuddle Plugin for Ark Server API                                                      *
+*                                                                                                                *
+*    This program is free software : you can redistribute it and/or modify                                       *
+*    it under the terms of the GNU General Public License as published by                                        *
+*    the Free Software Foundation, either version 3 of the License, or                                           *
+*    (at your option) any later version.                                                                         *
+*                                                                                                                *
+*    This program is distributed in the hope that it will be useful,                                             *
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of                                              *
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the                                                 *
+*    GNU General Public License for more details.                                                                *
+*                                                                                                                *
+*    You should have received a copy of the GNU General Public License                                           *
+*    along with this program.If not, see <https://www.gnu.org/licenses/>.                                        *
+*                                                                                                                *
+*****************************************************************************************************************/
+
+/**
+* \file Scheduler.h
+* \author Matthias Birnthaler Matthias-Birnthaler@outlook.com
+* \date 18 October 2026
+* \brief Implementation of the automatic imprint of dinos of offline tribes
+*
+*/
+
+
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+/* ================================================[includes]================================================ */
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+
+namespace Scheduler {
+
+    /* ================================================[declaration of public functions]========================= */
+
+    extern void Init(void);
+    extern void Shutdown(void);
+    extern void Schedule(uint64_t DinoId, double NextCuddleTime);
+    extern size_t GetPendingCount(void);
+    extern void QueueImprint(const std::vector<uint64_t>& DinoIds, float Increase);
+    extern size_t GetBulkPendingCount(void);
+}
+
+
+#endif /* SCHEDULER_H */
+
+/* =================================================[end of file]================================================= */
@@ -0,0 +1,650 @@
+/*****************************************************************************************************************
+* Copyright (C) 2019 by Matthias Birnthaler                                                                      *
+*                                                                                                                *
+* This file is part of the Cuddle Plugin for Ark Server API                                                      *
+*                                                                                                                *
+*    This program is free software : you can redistribute it and/or modify                                       *
+*    it under the terms of the GNU General Public License as published by                                        *
+*    the Free Software Foundation, either version 3 of the License, or                                           *
+*    (at your option) any later version.                                                                         *
+*                                                                                                                *
+*    This program is distributed in the hope that it will be useful,                                             *
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of                                              *
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the                                                 *
+*    GNU General Public License for more details.                                                                *
+*                                                                                                                *
+*    You should have received a copy of the GNU General Public License                                           *
+*    along with this program.If not, see <https://www.gnu.org/licenses/>.                                        *
+*                                                                                                                *
+*****************************************************************************************************************/
+
+/**
+* \file Tracker.cpp
+* \author Matthias Birnthaler Matthias-Birnthaler@outlook.com
+* \date 18 October 2026
+* \brief Implementation of the cuddle schedule of all dinos managed by the plugin
+*
+* Every change of the schedule is a journal record. The same record is applied to the in memory schedule
+* and appended to the journal, so the replay of the journal rebuilds exactly the same schedule.
+*/
+
+/* ================================================ [includes] ================================================ */
+#include "Tracker.h"
+#include "Journal.h"
+#include "Util.h"
+#include "Imprint.h"
+#include "Memory.h"
+
+#include <algorithm>
+#include <cmath>
+#include <unordered_map>
+#include <vector>
+
+
+namespace Tracker {
+
+    /* ============================================ [type definitions] ============================================ */
+    /** \brief factor to convert hours to secounds */
+    #define FACTOR_HOURS_TO_SECONDS     3600.0
+    /** \brief edge length of a cell of the spatial grid in unreal units */
+    #define TRACKER_GRID_CELL_SIZE      2000.0f
+    /** \brief largest coordinate of a cell in unreal units, far outside of every map, so the cell index can't overflow */
+    #define TRACKER_GRID_MAX_COORDINATE 1.0e8f
+    /** \brief number of dinos whose cell is refreshed per tick */
+    #define TRACKER_GRID_REFRESH_BUDGET 64u
+    /** \brief cells searched around the radius, for dinos that moved since the last refresh of their cell */
+    #define TRACKER_GRID_MARGIN         1
+
+    /* =============================================== [local data] =============================================== */
+
+    /** \brief the schedule of all managed dinos by dino id */
+    static std::unordered_map<uint64_t, DinoState_t> Tracker_Dinos;
+
+    /** \brief spatial grid of the spawned managed dinos, dino ids by cell. Entries of moved or removed dinos are dropped lazily */
+    static std::unordered_map<uint64_t, std::vector<uint64_t>> Tracker_Grid;
+
+    /** \brief the spawned dinos of the current round of cell refreshes */
+    static std::vector<uint64_t> Tracker_RefreshQueue;
+
+    /** \brief the next dino of Tracker_RefreshQueue whose cell is refreshed */
+    static size_t Tracker_RefreshIndex = 0u;
+
+    /** \brief server time of the latest applied record in secounds */
+    static double Tracker_LastTime = 0.0;
+
+    /* ===================================== [prototype of local functions] ======================================= */
+
+    static void ApplyRecord(const Journal::Record_t& Record);
+    static void CommitRecord(const Journal::Record_t& Record);
+    static std::vector<Journal::Record_t> TakeSnapshot(void);
+    static void AttachDino(uint64_t DinoId, APrimalDinoCharacter* Dino);
+    static uint64_t GetCell(int32_t X, int32_t Y);
+    static int32_t GetCellIndex(float Coordinate);
+    static void UpdateCell(uint64_t DinoId, DinoState_t* State);
+    static size_t GetDinosMemory(void);
+    static size_t GetGridMemory(void);
+
+
+    /**
+    * \brief ApplyRecord
+    *
+    * This function applies a journal record to the schedule
+    *
+    * \param[in] Record the record
+    * \return void
+    */
+    static void ApplyRecord(const Journal::Record_t& Record)
+    {
+        if ((Journal::RECORD_RELEASED == Record.Type) || (true == Imprint::IsFullyImprinted(Record.ImprintingQuality)))
+        {
+            Tracker_Dinos.erase(Record.DinoId);
+        }
+        else
+        {
+            DinoState_t& state = Tracker_Dinos[Record.DinoId];
+
+            state.LastUpdateTime = Record.Time;
+            state.NextCuddleTime = Record.NextCuddleTime;
+            state.ImprintingQuality = Record.ImprintingQuality;
+        }
+
+        if (Record.Time > Tracker_LastTime)
+        {
+            Tracker_LastTime = Record.Time;
+        }
+    }
+
+
+    /**
+    * \brief CommitRecord
+    *
+    * This function applies a record to the schedule, appends it to the journal and triggers the compaction
+    *
+    * \param[in] Record the record
+    * \return void
+    */
+    static void CommitRecord(const Journal::Record_t& Record)
+    {
+        ApplyRecord(Record);
+        Journal::Append(Record);
+
+        if (true == Journal::IsCompactionDue())
+        {
+            Journal::Compact(TakeSnapshot());
+            Memory::Sample();
+        }
+    }
+
+
+    /**
+    * \brief TakeSnapshot
+    *
+    * This function creates the snapshot records of the schedule. Dinos that missed their cuddle
+    * longer than the configured expire time are dropped from the schedule.
+    *
+    * \return std::vector<Journal::Record_t> the records of the snapshot
+    */
+    static std::vector<Journal::Record_t> TakeSnapshot(void)
+    {
+        std::vector<Journal::Record_t> snapshot;
+        const double expireTime = Tracker_LastTime - (Util::GetJournalConfig().ExpireTime * FACTOR_HOURS_TO_SECONDS);
+
+        snapshot.reserve(Tracker_Dinos.size());
+
+        for (auto it = Tracker_Dinos.begin(); it != Tracker_Dinos.end(); )
+        {
+            if (it->second.NextCuddleTime < expireTime)
+            {
+                it = Tracker_Dinos.erase(it);
+            }
+            else
+            {
+                Journal::Record_t record = {};
+
+                record.DinoId = it->first;
+                record.Time = it->second.LastUpdateTime;
+                record.NextCuddleTime = it->second.NextCuddleTime;
+                record.ImprintingQuality = it->second.ImprintingQuality;
+                record.Type = Journal::RECORD_SNAPSHOT;
+
+                snapshot.push_back(record);
+                ++it;
+            }
+        }
+
+        return snapshot;
+    }
+
+
+    /**
+    * \brief AttachDino
+    *
+    * This function attaches the spawned dino to its tracked state
+    *
+    * \param[in] DinoId the id of the dino
+    * \param[in] Dino the spawned dino
+    * \return void
+    */
+    static void AttachDino(uint64_t DinoId, APrimalDinoCharacter* Dino)
+    {
+        auto it = Tracker_Dinos.find(DinoId);
+
+        if (Tracker_Dinos.end() != it)
+        {
+            it->second.Dino = Dino;
+            it->second.CuddleType = Dino->BabyCuddleTypeField();
+            UpdateCell(DinoId, &it->second);
+        }
+    }
+
+
+    /**
+    * \brief GetCellIndex
+    *
+    * \param[in] Coordinate a coordinate of a location in unreal units, clamped to TRACKER_GRID_MAX_COORDINATE
+    * \return int32_t the index of the cell along the axis
+    */
+    static int32_t GetCellIndex(float Coordinate)
+    {
+        const float coordinate = std::min(std::max(Coordinate, -TRACKER_GRID_MAX_COORDINATE), TRACKER_GRID_MAX_COORDINATE);
+
+        return static_cast<int32_t>(std::floor(coordinate / TRACKER_GRID_CELL_SIZE));
+    }
+
+
+    /**
+    * \brief GetCell
+    *
+    * \param[in] X the cell index along the x axis
+    * \param[in] Y the cell index along the y axis
+    * \return uint64_t the key of the cell, never 0
+    */
+    static uint64_t GetCell(int32_t X, int32_t Y)
+    {
+        return ((static_cast<uint64_t>(static_cast<uint32_t>(X)) << 32) | static_cast<uint64_t>(static_cast<uint32_t>(Y))) ^ 0x8000000080000000ull;
+    }
+
+
+    /**
+    * \brief UpdateCell
+    *
+    * This function lists a spawned dino in the cell of its current location. The entry in the previous
+    * cell is left and dropped by the next search of that cell.
+    *
+    * \param[in] DinoId the id of the dino
+    * \param[in] State the tracked state of the dino
+    * \return void
+    */
+    static void UpdateCell(uint64_t DinoId, DinoState_t* State)
+    {
+        if (nullptr != State->Dino)
+        {
+            const FVector location = State->Dino->K2_GetActorLocation();
+            const uint64_t cell = GetCell(GetCellIndex(location.X), GetCellIndex(location.Y));
+
+            if (cell != State->Cell)
+            {
+                State->Cell = cell;
+                Tracker_Grid[cell].push_back(DinoId);
+            }
+        }
+    }
+
+
+    /**
+    * \brief GetDinosMemory
+    *
+    * \return size_t the bytes held by the tracked states
+    */
+    static size_t GetDinosMemory(void)
+    {
+        return Memory::GetHashBytes(Tracker_Dinos);
+    }
+
+
+    /**
+    * \brief GetGridMemory
+    *
+    * \return size_t the bytes held by the spatial grid
+    */
+    static size_t GetGridMemory(void)
+    {
+        size_t bytes = Memory::GetHashBytes(Tracker_Grid) + Memory::GetVectorBytes(Tracker_RefreshQueue);
+
+        for (const auto& cell : Tracker_Grid)
+        {
+            bytes += Memory::GetVectorBytes(cell.second);
+        }
+
+        return bytes;
+    }
+
+
+    /* ===================================== [definition of global functions] ===================================== */
+
+
+    /**
+    * \brief Init
+    *
+    * This function rebuilds the schedule from the journal and opens the journal for new records
+    *
+    * \return void
+    */
+    void Init(void)
+    {
+        Tracker_Dinos.clear();
+        Tracker_Grid.clear();
+        Tracker_RefreshQueue.clear();
+        Tracker_RefreshIndex = 0u;
+
+        Memory::Register("tracker.dinos", &GetDinosMemory);
+        Memory::Register("tracker.grid", &GetGridMemory);
+
+        if (true == Journal::Open(Util::GetJournalConfig(), &ApplyRecord))
+        {
+            if (true == Journal::IsCompactionDue())
+            {
+                Journal::Compact(TakeSnapshot());
+            }
+        }
+    }
+
+
+    /**
+    * \brief Shutdown
+    *
+    * This function writes the outstanding records and closes the journal
+    *
+    * \return void
+    */
+    void Shutdown(void)
+    {
+        Journal::Close();
+    }
+
+
+    /**
+    * \brief GetDinoId
+    *
+    * This function returns the unique id of a dino that stays the same over server restarts
+    *
+    * \param[in] Dino the dino
+    * \return uint64_t the id of the dino
+    */
+    uint64_t GetDinoId(APrimalDinoCharacter* Dino)
+    {
+        return ((static_cast<uint64_t>(Dino->DinoID1Field()) << 32) | static_cast<uint64_t>(Dino->DinoID2Field()));
+    }
+
+
+    /**
+    * \brief OnCuddleScheduled
+    *
+    * This function records the next cuddle of a managed dino
+    *
+    * \param[in] Dino the dino
+    * \param[in] Time the current server time in secounds
+    * \param[in] NextCuddleTime the server time of the next cuddle in secounds
+    * \return void
+    */
+    void OnCuddleScheduled(APrimalDinoCharacter* Dino, double Time, double NextCuddleTime)
+    {
+        if ((nullptr != Dino) && (nullptr != Dino->MyCharacterStatusComponentField()))
+        {
+            Journal::Record_t record = {};
+
+            record.DinoId = GetDinoId(Dino);
+            record.Time = Time;
+            record.NextCuddleTime = NextCuddleTime;
+            record.ImprintingQuality = Dino->MyCharacterStatusComponentField()->DinoImprintingQualityField();
+            record.Type = (false == Imprint::IsFullyImprinted(record.ImprintingQuality)) ? Journal::RECORD_SCHEDULED : Journal::RECORD_RELEASED;
+
+            CommitRecord(record);
+            AttachDino(record.DinoId, Dino);
+        }
+    }
+
+
+    /**
+    * \brief OnImprinted
+    *
+    * This function records the imprint of a managed dino after the imprinting quality has been updated
+    *
+    * \param[in] Dino the dino
+    * \param[in] Time the current server time in secounds
+    * \param[in] Amount the applied imprint increase
+    * \return void
+    */
+    void OnImprinted(APrimalDinoCharacter* Dino, double Time, float Amount)
+    {
+        if ((nullptr != Dino) && (nullptr != Dino->MyCharacterStatusComponentField()))
+        {
+            Journal::Record_t record = {};
+
+            record.DinoId = GetDinoId(Dino);
+            record.Time = Time;
+            record.NextCuddleTime = static_cast<double>(Dino->BabyNextCuddleTimeField());
+            record.Amount = Amount;
+            record.ImprintingQuality = Dino->MyCharacterStatusComponentField()->DinoImprintingQualityField();
+            record.Type = (false == Imprint::IsFullyImprinted(record.ImprintingQuality)) ? Journal::RECORD_IMPRINTED : Journal::RECORD_RELEASED;
+
+            CommitRecord(record);
+            AttachDino(record.DinoId, Dino);
+        }
+    }
+
+
+    /**
+    * \brief OnDinoSpawned
+    *
+    * This function attaches a spawned dino to its tracked state, e.g. after a server restart
+    *
+    * \param[in] Dino the spawned dino
+    * \return const DinoState_t* the tracked state of the dino or nullptr if the dino is not managed
+    */
+    const DinoState_t* OnDinoSpawned(APrimalDinoCharacter* Dino)
+    {
+        const DinoState_t* state = nullptr;
+
+        if ((nullptr != Dino) && (false == Tracker_Dinos.empty()))
+        {
+            auto it = Tracker_Dinos.find(GetDinoId(Dino));
+
+            if (Tracker_Dinos.end() != it)
+            {
+                it->second.Dino = Dino;
+                it->second.CuddleType = Dino->BabyCuddleTypeField();
+                UpdateCell(it->first, &it->second);
+                state = &it->second;
+            }
+        }
+
+        return state;
+    }
+
+
+    /**
+    * \brief OnDinoDestroyed
+    *
+    * This function detaches a destroyed dino from its tracked state, the schedule itself is kept
+    *
+    * \param[in] Dino the destroyed dino
+    * \return void
+    */
+    void OnDinoDestroyed(APrimalDinoCharacter* Dino)
+    {
+        if ((nullptr != Dino) && (false == Tracker_Dinos.empty()))
+        {
+            auto it = Tracker_Dinos.find(GetDinoId(Dino));
+
+            if ((Tracker_Dinos.end() != it) && (Dino == it->second.Dino))
+            {
+                it->second.Dino = nullptr;
+            }
+        }
+    }
+
+
+    /**
+    * \brief FindDino
+    *
+    * \param[in] DinoId the id of the dino
+    * \return const DinoState_t* the tracked state of the dino or nullptr if the dino is not managed
+    */
+    const DinoState_t* FindDino(uint64_t DinoId)
+    {
+        auto it = Tracker_Dinos.find(DinoId);
+
+        return (Tracker_Dinos.end() != it) ? &it->second : nullptr;
+    }
+
+
+    /**
+    * \brief GetDinoCount
+    *
+    * \return size_t the number of managed dinos
+    */
+    size_t GetDinoCount(void)
+    {
+        return Tracker_Dinos.size();
+    }
+
+
+    /**
+    * \brief FindDinosInRadius
+    *
+    * This function searches the spawned managed dinos within a radius by the spatial grid. The cells are refreshed
+    * by RefreshGrid, the search covers TRACKER_GRID_MARGIN cells around the radius for the dinos that moved since.
+    * The distance is checked at the current location. Dinos that moved to another cell are moved in the grid,
+    * stale entries of the searched cells are dropped.
+    *
+    * \param[in] Center the center of the search in unreal units
+    * \param[in] Radius the radius of the search in unreal units
+    * \param[out] DinoIds the ids of the found dinos
+    * \return void
+    */
+    void FindDinosInRadius(const FVector& Center, float Radius, std::vector<uint64_t>* DinoIds)
+    {
+        const float radiusSquared = Radius * Radius;
+        const int32_t minX = GetCellIndex(Center.X - Radius) - TRACKER_GRID_MARGIN;
+        const int32_t maxX = GetCellIndex(Center.X + Radius) + TRACKER_GRID_MARGIN;
+        const int32_t minY = GetCellIndex(Center.Y - Radius) - TRACKER_GRID_MARGIN;
+        const int32_t maxY = GetCellIndex(Center.Y + Radius) + TRACKER_GRID_MARGIN;
+        std::vector<uint64_t> cells;
+        std::vector<uint64_t> moved;
+
+        DinoIds->clear();
+
+        /* for a radius larger than the populated area visiting the populated cells is cheaper */
+        if ((static_cast<uint64_t>(maxX - minX + 1) * static_cast<uint64_t>(maxY - minY + 1)) > Tracker_Grid.size())
+        {
+            for (const auto& cell : Tracker_Grid)
+            {
+                cells.push_back(cell.first);
+            }
+        }
+        else
+        {
+            for (int32_t x = minX; x <= maxX; x++)
+            {
+                for (int32_t y = minY; y <= maxY; y++)
+                {
+                    cells.push_back(GetCell(x, y));
+                }
+            }
+        }
+
+        for (const uint64_t cell : cells)
+        {
+            auto gridCell = Tracker_Grid.find(cell);
+
+            if (Tracker_Grid.end() == gridCell)
+            {
+                continue;
+            }
+
+            std::vector<uint64_t>& entries = gridCell->second;
+
+            for (size_t index = 0; index < entries.size(); )
+            {
+                auto it = Tracker_Dinos.find(entries[index]);
+
+                if ((Tracker_Dinos.end() == it) || (nullptr == it->second.Dino) || (cell != it->second.Cell))
+                {
+                    /* released, despawned or already listed in another cell */
+                    entries[index] = entries.back();
+                    entries.pop_back();
+                    continue;
+                }
+
+                const FVector location = it->second.Dino->K2_GetActorLocation();
+                const float dx = location.X - Center.X;
+                const float dy = location.Y - Center.Y;
+                const float dz = location.Z - Center.Z;
+
+                if (((dx * dx) + (dy * dy) + (dz * dz)) <= radiusSquared)
+                {
+                    DinoIds->push_back(it->first);
+                }
+
+                if (cell != GetCell(GetCellIndex(location.X), GetCellIndex(location.Y)))
+                {
+                    moved.push_back(it->first);
+                }
+
+                index++;
+            }
+
+            if (true == entries.empty())
+            {
+                Tracker_Grid.erase(gridCell);
+            }
+        }
+
+        for (const uint64_t dinoId : moved)
+        {
+            UpdateCell(dinoId, &Tracker_Dinos[dinoId]);
+        }
+
+        std::sort(DinoIds->begin(), DinoIds->end());
+        DinoIds->erase(std::unique(DinoIds->begin(), DinoIds->end()), DinoIds->end());
+    }
+
+
+    /**
+    * \brief RefreshGrid
+    *
+    * This function moves up to TRACKER_GRID_REFRESH_BUDGET spawned dinos to the cell of their current location,
+    * so every dino is refreshed once per round over all spawned dinos. It is called by the tick of the scheduler.
+    *
+    * \return void
+    */
+    void RefreshGrid(void)
+    {
+        if (Tracker_RefreshIndex >= Tracker_RefreshQueue.size())
+        {
+            Tracker_RefreshQueue.clear();
+            Tracker_RefreshIndex = 0u;
+
+            for (const auto& dino : Tracker_Dinos)
+            {
+                if (nullptr != dino.second.Dino)
+                {
+                    Tracker_RefreshQueue.push_back(dino.first);
+                }
+            }
+        }
+
+        const size_t end = std::min(Tracker_RefreshIndex + TRACKER_GRID_REFRESH_BUDGET, Tracker_RefreshQueue.size());
+
+        for (; Tracker_RefreshIndex < end; Tracker_RefreshIndex++)
+        {
+            auto it = Tracker_Dinos.find(Tracker_RefreshQueue[Tracker_RefreshIndex]);
+
+            if (Tracker_Dinos.end() != it)
+            {
+                UpdateCell(it->first, &it->second);
+            }
+        }
+    }
+
+
+    /**
+    * \brief ExportSchedule
+    *
+    * This function exports the complete schedule as snapshot records
+    *
+    * \return std::vector<Journal::Record_t> the records of the schedule
+    */
+    std::vector<Journal::Record_t> ExportSchedule(void)
+    {
+        return TakeSnapshot();
+    }
+
+
+    /**
+    * \brief ImportSchedule
+    *
+    * This function replaces the schedule by the given records and compacts the journal to the new schedule
+    *
+    * \param[in] Records the records of the schedule
+    * \return void
+    */
+    void ImportSchedule(const std::vector<Journal::Record_t>& Records)
+    {
+        Tracker_Dinos.clear();
+        Tracker_Grid.clear();
+        Tracker_RefreshQueue.clear();
+        Tracker_RefreshIndex = 0u;
+
+        for (const Journal::Record_t& record : Records)
+        {
+            ApplyRecord(record);
+        }
+
+        Journal::Compact(TakeSnapshot());
+    }
+}
+
+
+/* =================================================[end of file]================================================= */
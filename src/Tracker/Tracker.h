@@ -0,0 +1,82 @@
+/*****************************************************************************************************************
+* Copyright (C) 2019 by Matthias Birnthaler                                                                      *
+*                                                                                                                *
+* This file is part of the Cuddle Plugin for Ark Server API                                                      *
+*                                                                                                                *
+*    This program is free software : you can redistribute it and/or modify                                       *
+*    it under the terms of the GNU General Public License as published by                                        *
+*    the Free Software Foundation, either version 3 of the License, or                                           *
+*    (at your option) any later version.                                                                         *
+*                                                                                                                *
+*    This program is distributed in the hope that it will be useful,                                             *
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of                                              *
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the                                                 *
+*    GNU General Public License for more details.                                                                *
+*                                                                                                                *
+*    You should have received a copy of the GNU General Public License                                           *
+*    along with this program.If not, see <https://www.gnu.org/licenses/>.                                        *
+*                                                                                                                *
+*****************************************************************************************************************/
+
+/**
+* \file Tracker.h
+* \author Matthias Birnthaler Matthias-Birnthaler@outlook.com
+* \date 18 October 2026
+* \brief Implementation of the cuddle schedule of all dinos managed by the plugin
+*
+*/
+
+
+#ifndef TRACKER_H
+#define TRACKER_H
+
+/* ================================================[includes]================================================ */
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include "API/ARK/Ark.h"
+#include "Journal.h"
+
+
+namespace Tracker {
+
+    /* ============================================ [type definitions] ============================================ */
+
+    /** \brief tracked state of a dino managed by the plugin */
+    struct DinoState_t {
+        /** \brief server time of the last update in secounds */
+        double LastUpdateTime;
+        /** \brief server time of the next cuddle in secounds */
+        double NextCuddleTime;
+        /** \brief the imprinting quality in floating point representation */
+        float ImprintingQuality;
+        /** \brief the spawned dino or nullptr if it is not spawned, not part of the journal */
+        APrimalDinoCharacter* Dino;
+        /** \brief the requested cuddle type (EBabyCuddleType) of the spawned dino, not part of the journal */
+        char CuddleType;
+        /** \brief the cell of the spatial grid the dino is listed in, 0 if not listed, not part of the journal */
+        uint64_t Cell;
+    };
+
+    /* ================================================[declaration of public functions]========================= */
+
+    extern void Init(void);
+    extern void Shutdown(void);
+    extern uint64_t GetDinoId(APrimalDinoCharacter* Dino);
+    extern void OnCuddleScheduled(APrimalDinoCharacter* Dino, double Time, double NextCuddleTime);
+    extern void OnImprinted(APrimalDinoCharacter* Dino, double Time, float Amount);
+    extern const DinoState_t* OnDinoSpawned(APrimalDinoCharacter* Dino);
+    extern void OnDinoDestroyed(APrimalDinoCharacter* Dino);
+    extern const DinoState_t* FindDino(uint64_t DinoId);
+    extern size_t GetDinoCount(void);
+    extern void FindDinosInRadius(const FVector& Center, float Radius, std::vector<uint64_t>* DinoIds);
+    extern void RefreshGrid(void);
+    extern std::vector<Journal::Record_t> ExportSchedule(void);
+    extern void ImportSchedule(const std::vector<Journal::Record_t>& Records);
+}
+
+
+#endif /* TRACKER_H */
+
+/* =================================================[end of file]================================================= */
@@ -0,0 +1,241 @@
+/*****************************************************************************************************************
+* Copyright (C) 2019 by Matthias Birnthaler                                                                      *
+*                                                                                                                *
+* This file is part of the Cuddle Plugin for Ark Server API                                                      *
+*                                                                                                                *
+*    This program is free software : you can redistribute it and/or modify                                       *
+*    it under the terms of the GNU General Public License as published by                                        *
+*    the Free Software Foundation, either version 3 of the License, or                                           *
+*    (at your option) any later version.                                                                         *
+*                                                                                                                *
+*    This program is distributed in the hope that it will be useful,                                             *
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of                                              *
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the                                                 *
+*    GNU General Public License for more details.                                                                *
+*                                                                                                                *
+*    You should have received a copy of the GNU General Public License                                           *
+*    along with this program.If not, see <https://www.gnu.org/licenses/>.                                        *
+*                                                                                                                *
+*****************************************************************************************************************/
+
+/**
+* \file ImprintBenchmark.cpp
+* \author Matthias Birnthaler Matthias-Birnthaler@outlook.com
+* \date 18 October 2026
+* \brief Throughput of the batch imprint update against per-dino hook-style updates
+*
+* The hook-style update reads the imprinting quality of every dino through its own object and applies the
+* added amount and the new quality in two calls, like the hooks of AddedImprintingQuality and
+* UpdateImprintingQuality. The batch update runs ApplyIncrease over a structure of arrays. The batch
+* evaluation runs EvaluateBatch with the selected SIMD implementation, like the bulk imprints of the
+* scheduler, and also computes the next cuddle times. The lookup of the dino tags is measured afterwards
+* by RunLookupBenchmark. Usage: Imprint_Benchmark [dinos] [rounds]
+*/
+
+
+/* ================================================ [includes] ================================================ */
+#include "Imprint.h"
+#include "LookupBenchmark.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+
+/* ============================================ [type definitions] ============================================ */
+
+/** \brief stand-in of a dino object, the imprinting quality is one member of a larger object */
+struct BenchmarkDino_t {
+    /** \brief members in front of the imprinting quality */
+    char Padding[256];
+    /** \brief the imprinting quality */
+    float ImprintingQuality;
+    /** \brief the sum of the added amounts */
+    float AddedAmount;
+};
+
+/** \brief a hook-style update function, called through a pointer like a detoured game function */
+typedef void(*UpdateFunction_t)(BenchmarkDino_t* Dino, float Value);
+
+/* ===================================== [prototype of local functions] ======================================= */
+
+static void AddedImprintingQuality(BenchmarkDino_t* Dino, float Amount);
+static void UpdateImprintingQuality(BenchmarkDino_t* Dino, float Quality);
+static double MeasureHookStyle(std::vector<std::unique_ptr<BenchmarkDino_t>>& Dinos, const std::vector<float>& Increase, int Rounds);
+static double MeasureBatch(std::vector<float>& Quality, const std::vector<float>& Increase, std::vector<float>& Amount, int Rounds);
+static double MeasureEvaluateBatch(const Imprint::BatchView_t& Batch, int Rounds);
+
+/* =============================================== [local data] =============================================== */
+
+/** \brief the added amount is applied through a pointer, so the call is not inlined */
+static volatile UpdateFunction_t Benchmark_AddedImprintingQuality = &AddedImprintingQuality;
+
+/** \brief the new quality is applied through a pointer, so the call is not inlined */
+static volatile UpdateFunction_t Benchmark_UpdateImprintingQuality = &UpdateImprintingQuality;
+
+
+/* ===================================== [definition of local functions] ====================================== */
+
+
+/**
+* \brief AddedImprintingQuality
+*
+* \param[in] Dino the dino
+* \param[in] Amount the added amount
+* \return void
+*/
+static void AddedImprintingQuality(BenchmarkDino_t* Dino, float Amount)
+{
+    Dino->AddedAmount += Amount;
+}
+
+
+/**
+* \brief UpdateImprintingQuality
+*
+* \param[in] Dino the dino
+* \param[in] Quality the new imprinting quality
+* \return void
+*/
+static void UpdateImprintingQuality(BenchmarkDino_t* Dino, float Quality)
+{
+    Dino->ImprintingQuality = Quality;
+}
+
+
+/**
+* \brief MeasureHookStyle
+*
+* \param[in,out] Dinos the dinos
+* \param[in] Increase the increase of every dino
+* \param[in] Rounds the number of updates of every dino
+* \return double the nanoseconds per dino update
+*/
+static double MeasureHookStyle(std::vector<std::unique_ptr<BenchmarkDino_t>>& Dinos, const std::vector<float>& Increase, int Rounds)
+{
+    const auto start = std::chrono::steady_clock::now();
+
+    for (int round = 0; round < Rounds; round++)
+    {
+        for (size_t index = 0; index < Dinos.size(); index++)
+        {
+            BenchmarkDino_t* dino = Dinos[index].get();
+
+            Benchmark_AddedImprintingQuality(dino, Imprint::GetAddedAmount(dino->ImprintingQuality, Increase[index]));
+            Benchmark_UpdateImprintingQuality(dino, Imprint::AddQuality(dino->ImprintingQuality, Increase[index]));
+        }
+    }
+
+    const std::chrono::duration<double, std::nano> duration = std::chrono::steady_clock::now() - start;
+
+    return duration.count() / (static_cast<double>(Rounds) * static_cast<double>(Dinos.size()));
+}
+
+
+/**
+* \brief MeasureBatch
+*
+* \param[in,out] Quality the imprinting quality of every dino
+* \param[in] Increase the increase of every dino
+* \param[out] Amount the added amount of every dino
+* \param[in] Rounds the number of updates of every dino
+* \return double the nanoseconds per dino update
+*/
+static double MeasureBatch(std::vector<float>& Quality, const std::vector<float>& Increase, std::vector<float>& Amount, int Rounds)
+{
+    const auto start = std::chrono::steady_clock::now();
+
+    for (int round = 0; round < Rounds; round++)
+    {
+        Imprint::ApplyIncrease(Quality.data(), Increase.data(), Amount.data(), Quality.size());
+    }
+
+    const std::chrono::duration<double, std::nano> duration = std::chrono::steady_clock::now() - start;
+
+    return duration.count() / (static_cast<double>(Rounds) * static_cast<double>(Quality.size()));
+}
+
+
+/**
+* \brief MeasureEvaluateBatch
+*
+* \param[in] Batch the batch of dinos, the qualities and the deadlines are updated
+* \param[in] Rounds the number of updates of every dino
+* \return double the nanoseconds per dino update
+*/
+static double MeasureEvaluateBatch(const Imprint::BatchView_t& Batch, int Rounds)
+{
+    const auto start = std::chrono::steady_clock::now();
+
+    for (int round = 0; round < Rounds; round++)
+    {
+        Imprint::EvaluateBatch(Batch, static_cast<double>(round));
+    }
+
+    const std::chrono::duration<double, std::nano> duration = std::chrono::steady_clock::now() - start;
+
+    return duration.count() / (static_cast<double>(Rounds) * static_cast<double>(Batch.Count));
+}
+
+
+/* ===================================== [definition of global functions] ===================================== */
+
+
+/**
+* \brief main
+*
+* \param[in] argc number of arguments
+* \param[in] argv the number of dinos and the number of rounds
+* \return int the result of the lookup benchmark
+*/
+int main(int argc, char* argv[])
+{
+    const size_t count = (1 < argc) ? static_cast<size_t>(std::strtoul(argv[1], nullptr, 10)) : 4096u;
+    const int rounds = (2 < argc) ? std::atoi(argv[2]) : 20000;
+    std::vector<std::unique_ptr<BenchmarkDino_t>> dinos;
+    std::vector<float> quality(count);
+    std::vector<float> increase(count);
+    std::vector<float> amount(count);
+    std::vector<float> evaluated(count);
+    std::vector<float> interval(count, 480.0f);
+    std::vector<float> maturationTime(count, 86400.0f);
+    std::vector<double> deadline(count);
+    float checksum = 0.0f;
+    float evaluatedChecksum = 0.0f;
+
+    for (size_t index = 0; index < count; index++)
+    {
+        /* the increases alternate in sign, so the qualities keep moving instead of saturating at 1 */
+        quality[index] = static_cast<float>(index % 100u) / 100.0f;
+        increase[index] = ((0u == (index % 2u)) ? 1.0f : -1.0f) * (0.001f + (static_cast<float>(index % 7u) / 100.0f));
+
+        evaluated[index] = quality[index];
+
+        dinos.push_back(std::make_unique<BenchmarkDino_t>());
+        dinos.back()->ImprintingQuality = quality[index];
+        dinos.back()->AddedAmount = 0.0f;
+    }
+
+    const double hookStyle = MeasureHookStyle(dinos, increase, rounds);
+    const double batch = MeasureBatch(quality, increase, amount, rounds);
+    const double evaluate = MeasureEvaluateBatch({ evaluated.data(), increase.data(), interval.data(), maturationTime.data(), deadline.data(), count }, rounds);
+
+    for (size_t index = 0; index < count; index++)
+    {
+        checksum += (dinos[index]->ImprintingQuality - quality[index]);
+        evaluatedChecksum += (evaluated[index] - quality[index]);
+    }
+
+    std::printf("dinos: %zu, rounds: %d\n", count, rounds);
+    std::printf("hook-style: %.3f ns per dino\n", hookStyle);
+    std::printf("batch:      %.3f ns per dino (%.1fx)\n", batch, hookStyle / batch);
+    std::printf("evaluate:   %.3f ns per dino (%.1fx, %s)\n", evaluate, hookStyle / evaluate, Imprint::GetBatchImplementation());
+    std::printf("difference of the results: %g, %g\n", checksum, evaluatedChecksum);
+
+    return RunLookupBenchmark(rounds);
+}
+
+
+/* =================================================[end of file]================================================= */
@@ -0,0 +1,267 @@
+/*****************************************************************************************************************
+* Copyright (C) 2019 by Matthias Birnthaler                                                                      *
+*                                                                                                                *
+* This file is part of the Cuddle Plugin for Ark Server API                                                      *
+*                                                                                                                *
+*    This program is free software : you can redistribute it and/or modify                                       *
+*    it under the terms of the GNU General Public License as published by                                        *
+*    the Free Software Foundation, either version 3 of the License, or                                           *
+*    (at your option) any later version.                                                                         *
+*                                                                                                                *
+*    This program is distributed in the hope that it will be useful,                                             *
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of                                              *
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the                                                 *
+*    GNU General Public License for more details.                                                                *
+*                                                                                                                *
+*    You should have received a copy of the GNU General Public License                                           *
+*    along with this program.If not, see <https://www.gnu.org/licenses/>.                                        *
+*                                                                                                                *
+*****************************************************************************************************************/
+
+/**
+* \file ImprintTest.cpp
+* \author Matthias Birnthaler Matthias-Birnthaler@outlook.com
+* \date 18 October 2026
+* \brief Unit tests of the imprint kernel
+*/
+
+
+/* ================================================ [includes] ================================================ */
+#include "Imprint.h"
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+
+/* =============================================== [local data] =============================================== */
+
+/** \brief number of steps of the quality grid over 0..1 */
+static const int ImprintTest_GridSteps = 100000;
+
+/** \brief increases that are applied to every quality of the grid */
+static const float ImprintTest_Increases[] = { -2.0f, -1.0f, -0.5f, -0.0001f, 0.0f, 0.000001f, 0.0001f, 0.05f, 0.333333f, 0.5f, 1.0f, 2.0f };
+
+/* ===================================== [prototype of local functions] ======================================= */
+
+static float GetGridQuality(int Step);
+static bool IsSameFloat(float A, float B);
+
+
+/* ===================================== [definition of local functions] ====================================== */
+
+
+/**
+* \brief GetGridQuality
+*
+* \param[in] Step the step of the quality grid
+* \return float the quality of the step, the grid exceeds 0..1 by 10% at both ends
+*/
+static float GetGridQuality(int Step)
+{
+    return -0.1f + (1.2f * static_cast<float>(Step) / static_cast<float>(ImprintTest_GridSteps));
+}
+
+
+/**
+* \brief IsSameFloat
+*
+* \param[in] A first value
+* \param[in] B second value
+* \return bool: true if both values have the same bit pattern, otherwise false
+*/
+static bool IsSameFloat(float A, float B)
+{
+    return (0 == std::memcmp(&A, &B, sizeof(float)));
+}
+
+
+/* ================================================= [tests] ================================================== */
+
+
+TEST(ImprintTest, ClampQualityOfNaNIsZero)
+{
+    EXPECT_EQ(0.0f, Imprint::ClampQuality(std::numeric_limits<float>::quiet_NaN()));
+}
+
+
+TEST(ImprintTest, ClampQualityOutOfRange)
+{
+    EXPECT_EQ(0.0f, Imprint::ClampQuality(-0.5f));
+    EXPECT_EQ(0.0f, Imprint::ClampQuality(-std::numeric_limits<float>::infinity()));
+    EXPECT_EQ(1.0f, Imprint::ClampQuality(1.5f));
+    EXPECT_EQ(1.0f, Imprint::ClampQuality(std::numeric_limits<float>::infinity()));
+    EXPECT_EQ(0.25f, Imprint::ClampQuality(0.25f));
+}
+
+
+TEST(ImprintTest, AddQualityTreatsNaNQualityAsZero)
+{
+    EXPECT_EQ(0.25f, Imprint::AddQuality(std::numeric_limits<float>::quiet_NaN(), 0.25f));
+    EXPECT_EQ(0.25f, Imprint::GetAddedAmount(std::numeric_limits<float>::quiet_NaN(), 0.25f));
+    EXPECT_FALSE(Imprint::IsFullyImprinted(std::numeric_limits<float>::quiet_NaN()));
+}
+
+
+TEST(ImprintTest, AddQualityWithNaNIncreaseStaysInRange)
+{
+    const float quality = Imprint::AddQuality(0.5f, std::numeric_limits<float>::quiet_NaN());
+
+    EXPECT_FALSE(std::isnan(quality));
+    EXPECT_LE(0.0f, quality);
+    EXPECT_GE(1.0f, quality);
+}
+
+
+TEST(ImprintTest, AddQualityClampsNegativeAndAboveOne)
+{
+    EXPECT_EQ(0.0f, Imprint::AddQuality(0.25f, -0.5f));
+    EXPECT_EQ(0.25f, Imprint::AddQuality(-0.5f, 0.25f));
+    EXPECT_EQ(1.0f, Imprint::AddQuality(0.75f, 0.5f));
+    EXPECT_EQ(1.0f, Imprint::AddQuality(1.5f, 0.0f));
+    EXPECT_EQ(0.5f, Imprint::AddQuality(1.5f, -0.5f));
+
+    EXPECT_EQ(0.25f, Imprint::GetAddedAmount(0.75f, 0.5f));
+    EXPECT_EQ(-0.25f, Imprint::GetAddedAmount(0.25f, -0.5f));
+    EXPECT_EQ(0.0f, Imprint::GetAddedAmount(1.5f, 0.5f));
+}
+
+
+TEST(ImprintTest, EpsilonBoundary)
+{
+    const float full = 1.0f - IMPRINT_EPSILON;
+    const float below = std::nextafter(full, 0.0f);
+
+    EXPECT_TRUE(Imprint::IsFullyImprinted(full));
+    EXPECT_TRUE(Imprint::IsFullyImprinted(1.0f));
+    EXPECT_FALSE(Imprint::IsFullyImprinted(below));
+
+    EXPECT_EQ(1.0f, Imprint::AddQuality(full, 0.0f));
+    EXPECT_EQ(below, Imprint::AddQuality(below, 0.0f));
+    EXPECT_EQ(1.0f, Imprint::AddQuality(below, IMPRINT_EPSILON));
+}
+
+
+TEST(ImprintTest, IncreaseOfZero)
+{
+    for (int step = 0; step <= ImprintTest_GridSteps; step++)
+    {
+        const float quality = GetGridQuality(step);
+        const float expected = Imprint::IsFullyImprinted(Imprint::ClampQuality(quality)) ? 1.0f : Imprint::ClampQuality(quality);
+
+        ASSERT_EQ(expected, Imprint::AddQuality(quality, 0.0f)) << "quality " << quality;
+    }
+}
+
+
+TEST(ImprintTest, GridStaysInRangeAndIsMonotonic)
+{
+    for (int step = 0; step <= ImprintTest_GridSteps; step++)
+    {
+        const float quality = GetGridQuality(step);
+        float previous = -1.0f;
+
+        for (float increase : ImprintTest_Increases)
+        {
+            const float result = Imprint::AddQuality(quality, increase);
+
+            ASSERT_LE(0.0f, result) << "quality " << quality << ", increase " << increase;
+            ASSERT_GE(1.0f, result) << "quality " << quality << ", increase " << increase;
+            ASSERT_LE(previous, result) << "quality " << quality << ", increase " << increase;
+            ASSERT_EQ(result - Imprint::ClampQuality(quality), Imprint::GetAddedAmount(quality, increase));
+
+            previous = result;
+        }
+    }
+}
+
+
+TEST(ImprintTest, ApplyIncreaseMatchesScalarKernel)
+{
+    std::vector<float> quality;
+    std::vector<float> increase;
+
+    for (int step = 0; step <= ImprintTest_GridSteps; step += 97)
+    {
+        for (float value : ImprintTest_Increases)
+        {
+            quality.push_back(GetGridQuality(step));
+            increase.push_back(value);
+        }
+    }
+
+    quality.push_back(std::numeric_limits<float>::quiet_NaN());
+    increase.push_back(0.5f);
+    quality.push_back(1.0f - IMPRINT_EPSILON);
+    increase.push_back(0.0f);
+
+    const std::vector<float> previous = quality;
+    std::vector<float> amount(quality.size());
+    std::vector<float> withoutAmount = previous;
+
+    Imprint::ApplyIncrease(quality.data(), increase.data(), amount.data(), quality.size());
+    Imprint::ApplyIncrease(withoutAmount.data(), increase.data(), nullptr, withoutAmount.size());
+
+    for (size_t index = 0; index < quality.size(); index++)
+    {
+        ASSERT_TRUE(IsSameFloat(Imprint::AddQuality(previous[index], increase[index]), quality[index])) << "index " << index;
+        ASSERT_TRUE(IsSameFloat(Imprint::GetAddedAmount(previous[index], increase[index]), amount[index])) << "index " << index;
+        ASSERT_TRUE(IsSameFloat(quality[index], withoutAmount[index])) << "index " << index;
+    }
+}
+
+
+TEST(ImprintTest, EvaluateBatchMatchesScalarKernel)
+{
+    const double now = 123456.25;
+    std::vector<float> quality;
+    std::vector<float> increase;
+    std::vector<float> interval;
+    std::vector<float> maturationTime;
+
+    for (int step = 0; step <= ImprintTest_GridSteps; step += 97)
+    {
+        for (float value : ImprintTest_Increases)
+        {
+            quality.push_back(GetGridQuality(step));
+            increase.push_back(value);
+            interval.push_back(static_cast<float>(step % 13) * 60.0f);
+            maturationTime.push_back(86400.0f + static_cast<float>(step));
+        }
+    }
+
+    /* the count is not a multiple of the vector width, so the remainder is evaluated too */
+    quality.push_back(std::numeric_limits<float>::quiet_NaN());
+    increase.push_back(0.5f);
+    interval.push_back(480.0f);
+    maturationTime.push_back(3600.0f);
+    quality.push_back(1.0f - IMPRINT_EPSILON);
+    increase.push_back(0.0f);
+    interval.push_back(480.0f);
+    maturationTime.push_back(3600.0f);
+    quality.push_back(0.25f);
+    increase.push_back(std::numeric_limits<float>::quiet_NaN());
+    interval.push_back(480.0f);
+    maturationTime.push_back(3600.0f);
+
+    const std::vector<float> previous = quality;
+    std::vector<double> deadline(quality.size());
+
+    Imprint::EvaluateBatch({ quality.data(), increase.data(), interval.data(), maturationTime.data(), deadline.data(), quality.size() }, now);
+
+    ASSERT_NE(nullptr, Imprint::GetBatchImplementation());
+
+    for (size_t index = 0; index < quality.size(); index++)
+    {
+        const float expected = Imprint::AddQuality(previous[index], increase[index]);
+        const float delay = Imprint::IsFullyImprinted(expected) ? maturationTime[index] : interval[index];
+
+        ASSERT_TRUE(IsSameFloat(expected, quality[index])) << "index " << index << " (" << Imprint::GetBatchImplementation() << ")";
+        ASSERT_EQ(now + static_cast<double>(delay), deadline[index]) << "index " << index << " (" << Imprint::GetBatchImplementation() << ")";
+    }
+}
+
+
+/* =================================================[end of file]================================================= */
@@ -0,0 +1,417 @@
+/*****************************************************************************************************************
+* Copyright (C) 2019 by Matthias Birnthaler                                                                      *
+*                                                                                                                *
+* This file is part of the Cuddle Plugin for Ark Server API                                                      *
+*                                                                                                                *
+*    This program is free software : you can redistribute it and/or modify                                       *
+*    it under the terms of the GNU General Public License as published by                                        *
+*    the Free Software Foundation, either version 3 of the License, or                                           *
+*    (at your option) any later version.                                                                         *
+*                                                                                                                *
+*    This program is distributed in the hope that it will be useful,                                             *
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of                                              *
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the                                                 *
+*    GNU General Public License for more details.                                                                *
+*                                                                                                                *
+*    You should have received a copy of the GNU General Public License                                           *
+*    along with this program.If not, see <https://www.gnu.org/licenses/>.                                        *
+*                                                                                                                *
+*****************************************************************************************************************/
+
+/**
+* \file LookupBenchmark.cpp
+* \author Matthias Birnthaler Matthias-Birnthaler@outlook.com
+* \date 18 October 2026
+* \brief Benchmark of the dino tag lookup
+*
+* The miss path compares the lookup of a dino tag that is not configured before and after the dino filter:
+* before, the dino tag was converted to a narrow string and looked up in a std::map of the configured tags,
+* now the name index is rejected by the blocked bloom filter. The hit path compares the lookup of configured
+* dino tags in a configuration of LOOKUP_BENCHMARK_SPECIES tags, the std::map against the probe of the open
+* addressed species table, in random order so the lookups are not served by a warm cache line.
+*
+* The footprint compares the bytes of the species table with the former std::map for growing configurations.
+* A table above LOOKUP_BENCHMARK_MAX_BYTES_PER_SPECIES fails the benchmark, so it is run as a test as well.
+*/
+
+
+/* ================================================ [includes] ================================================ */
+#include "LookupBenchmark.h"
+#include "Lookup.h"
+#include "Memory.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+
+/* ============================================ [type definitions] ============================================ */
+
+/** \brief number of configured dino tags of the miss path, a large server configuration */
+#define LOOKUP_BENCHMARK_CONFIGURED     200u
+/** \brief number of dino tags that are looked up per round */
+#define LOOKUP_BENCHMARK_QUERIES        4096u
+/** \brief number of configured dino tags of the hit path, a large modded server */
+#define LOOKUP_BENCHMARK_SPECIES        10000u
+/** \brief budget of the species table per configured dino tag, slots, statistics, sort order and name */
+#define LOOKUP_BENCHMARK_MAX_BYTES_PER_SPECIES  256u
+
+/** \brief stand-in of the slot of the species table, with the same members */
+struct BenchmarkSlot_t {
+    /** \brief name index of the dino tag */
+    int32_t NameIndex;
+    /** \brief offset of the dino tag in the name pool */
+    uint32_t NameOffset;
+    /** \brief the cuddle interval time */
+    float CuddleIntervalTime;
+    /** \brief the increase per cuddle */
+    float CuddleIncreasePercent;
+    /** \brief number of cuddles */
+    uint16_t CuddleCount;
+    /** \brief index of the interval curve */
+    int16_t IntervalCurve;
+    /** \brief index of the cuddle type mix */
+    int16_t CuddleMix;
+    /** \brief the species flags */
+    uint16_t Flags;
+};
+
+/** \brief stand-in of the lookup statistics of a slot, with the same members */
+struct BenchmarkStats_t {
+    /** \brief number of resolved lookups */
+    uint64_t Resolved;
+    /** \brief number of deferred lookups */
+    uint64_t Deferred;
+    /** \brief the layers of the last lookup */
+    uint32_t Layers;
+};
+
+/** \brief stand-in of the former map value, the cuddle data of a dino tag */
+struct BenchmarkCuddleData_t {
+    /** \brief the increase per cuddle */
+    float CuddleIncreasePercent;
+    /** \brief the cuddle interval time */
+    float CuddleIntervalTime;
+    /** \brief automatic imprint */
+    bool AutoImprint;
+};
+
+/* ===================================== [prototype of local functions] ======================================= */
+
+static std::wstring GetDinoTag(int NameIndex);
+static double MeasureMapMiss(const std::map<std::string, BenchmarkCuddleData_t>& Dinolist, const std::vector<std::wstring>& Tags, int Rounds, size_t* Found);
+static double MeasureFilterMiss(const uint64_t* Filter, const std::vector<int>& NameIndices, int Rounds, size_t* Found);
+static double MeasureMapHit(const std::map<std::string, BenchmarkCuddleData_t>& Dinolist, const std::vector<std::wstring>& Tags, int Rounds, float* Checksum);
+static double MeasureTableHit(const std::vector<BenchmarkSlot_t>& Slots, uint32_t Shift, const std::vector<int>& NameIndices, int Rounds, float* Checksum);
+static size_t GetTableBytes(size_t Species, size_t NameBytes);
+static bool MeasureFootprint(size_t Species);
+
+
+/* ===================================== [definition of local functions] ====================================== */
+
+
+/**
+* \brief GetDinoTag
+*
+* \param[in] NameIndex the name index
+* \return std::wstring the dino tag of the name index, as the game stores it
+*/
+static std::wstring GetDinoTag(int NameIndex)
+{
+    return L"Dino_" + std::to_wstring(NameIndex);
+}
+
+
+/**
+* \brief MeasureMapMiss
+*
+* \param[in] Dinolist the configured dino tags
+* \param[in] Tags the dino tags that are looked up
+* \param[in] Rounds the number of lookups of every tag
+* \param[out] Found the number of tags that were found
+* \return double the nanoseconds per lookup
+*/
+static double MeasureMapMiss(const std::map<std::string, BenchmarkCuddleData_t>& Dinolist, const std::vector<std::wstring>& Tags, int Rounds, size_t* Found)
+{
+    const auto start = std::chrono::steady_clock::now();
+
+    *Found = 0u;
+
+    for (int round = 0; round < Rounds; round++)
+    {
+        for (const std::wstring& tag : Tags)
+        {
+            const std::string name(tag.begin(), tag.end());
+
+            *Found += (Dinolist.end() != Dinolist.find(name)) ? 1u : 0u;
+        }
+    }
+
+    const std::chrono::duration<double, std::nano> duration = std::chrono::steady_clock::now() - start;
+
+    return duration.count() / (static_cast<double>(Rounds) * static_cast<double>(Tags.size()));
+}
+
+
+/**
+* \brief MeasureFilterMiss
+*
+* \param[in] Filter the dino filter over the configured name indices
+* \param[in] NameIndices the name indices that are looked up
+* \param[in] Rounds the number of lookups of every name index
+* \param[out] Found the number of name indices that passed the filter (false positives)
+* \return double the nanoseconds per lookup
+*/
+static double MeasureFilterMiss(const uint64_t* Filter, const std::vector<int>& NameIndices, int Rounds, size_t* Found)
+{
+    const auto start = std::chrono::steady_clock::now();
+
+    *Found = 0u;
+
+    for (int round = 0; round < Rounds; round++)
+    {
+        for (int nameIndex : NameIndices)
+        {
+            *Found += (true == Lookup::ProbeFilter(Filter, nameIndex)) ? 1u : 0u;
+        }
+    }
+
+    const std::chrono::duration<double, std::nano> duration = std::chrono::steady_clock::now() - start;
+
+    return duration.count() / (static_cast<double>(Rounds) * static_cast<double>(NameIndices.size()));
+}
+
+
+/**
+* \brief MeasureMapHit
+*
+* \param[in] Dinolist the configured dino tags
+* \param[in] Tags the configured dino tags in the order of the lookups
+* \param[in] Rounds the number of lookups of every tag
+* \param[out] Checksum the sum of the interval times, so the lookups are not optimized away
+* \return double the nanoseconds per lookup
+*/
+static double MeasureMapHit(const std::map<std::string, BenchmarkCuddleData_t>& Dinolist, const std::vector<std::wstring>& Tags, int Rounds, float* Checksum)
+{
+    const auto start = std::chrono::steady_clock::now();
+
+    *Checksum = 0.0f;
+
+    for (int round = 0; round < Rounds; round++)
+    {
+        for (const std::wstring& tag : Tags)
+        {
+            const std::string name(tag.begin(), tag.end());
+            auto entry = Dinolist.find(name);
+
+            *Checksum += (Dinolist.end() != entry) ? (entry->second.CuddleIntervalTime * 60.0f) : 0.0f;
+        }
+    }
+
+    const std::chrono::duration<double, std::nano> duration = std::chrono::steady_clock::now() - start;
+
+    return duration.count() / (static_cast<double>(Rounds) * static_cast<double>(Tags.size()));
+}
+
+
+/**
+* \brief MeasureTableHit
+*
+* \param[in] Slots the species table
+* \param[in] Shift the shift of the hash to the slot index
+* \param[in] NameIndices the configured name indices in the order of the lookups
+* \param[in] Rounds the number of lookups of every name index
+* \param[out] Checksum the sum of the interval times, so the lookups are not optimized away
+* \return double the nanoseconds per lookup
+*/
+static double MeasureTableHit(const std::vector<BenchmarkSlot_t>& Slots, uint32_t Shift, const std::vector<int>& NameIndices, int Rounds, float* Checksum)
+{
+    const auto start = std::chrono::steady_clock::now();
+
+    *Checksum = 0.0f;
+
+    for (int round = 0; round < Rounds; round++)
+    {
+        for (int nameIndex : NameIndices)
+        {
+            const BenchmarkSlot_t& slot = Slots[Lookup::ProbeTable(Slots.data(), Shift, nameIndex)];
+
+            *Checksum += (0 != slot.NameIndex) ? slot.CuddleIntervalTime : 0.0f;
+        }
+    }
+
+    const std::chrono::duration<double, std::nano> duration = std::chrono::steady_clock::now() - start;
+
+    return duration.count() / (static_cast<double>(Rounds) * static_cast<double>(NameIndices.size()));
+}
+
+
+/**
+* \brief GetTableBytes
+*
+* This function reserves the species table like the compilation of the configuration does
+*
+* \param[in] Species the number of configured dino tags
+* \param[in] NameBytes the bytes of the zero terminated dino tags
+* \return size_t the bytes of the species table, its statistics, the sort order, the names and the filter
+*/
+static size_t GetTableBytes(size_t Species, size_t NameBytes)
+{
+    const size_t slotCount = static_cast<size_t>(1ull << (64u - Lookup::GetTableShift(Species)));
+    size_t capacity = Memory::Reserve(0u, slotCount * sizeof(BenchmarkSlot_t), alignof(BenchmarkSlot_t));
+
+    capacity = Memory::Reserve(capacity, Species * sizeof(uint32_t), alignof(uint32_t));
+    capacity = Memory::Reserve(capacity, NameBytes, alignof(char));
+    capacity = Memory::Reserve(capacity, slotCount * sizeof(BenchmarkStats_t), alignof(BenchmarkStats_t));
+
+    return capacity + (LOOKUP_FILTER_WORDS * sizeof(uint64_t));
+}
+
+
+/**
+* \brief MeasureFootprint
+*
+* \param[in] Species the number of configured dino tags
+* \return bool: true if the species table is within the budget, otherwise false
+*/
+static bool MeasureFootprint(size_t Species)
+{
+    std::map<std::string, BenchmarkCuddleData_t> dinolist;
+    size_t nameBytes = 0u;
+    size_t mapBytes = 0u;
+
+    for (size_t index = 0u; index < Species; index++)
+    {
+        const std::wstring tag = GetDinoTag(static_cast<int>(index + 1u));
+
+        dinolist[std::string(tag.begin(), tag.end())] = { 0.1f, 480.0f, false };
+        nameBytes += tag.size() + 1u;
+    }
+
+    mapBytes = Memory::GetTreeBytes(dinolist);
+
+    for (const auto& entry : dinolist)
+    {
+        mapBytes += Memory::GetStringBytes(entry.first);
+    }
+
+    const size_t tableBytes = GetTableBytes(Species, nameBytes);
+    const bool result = (tableBytes <= (Species * LOOKUP_BENCHMARK_MAX_BYTES_PER_SPECIES));
+
+    std::printf("  %6zu tags: table %8zu bytes (%5.1f per tag), map %8zu bytes (%5.1f per tag)%s\n", Species,
+        tableBytes, static_cast<double>(tableBytes) / static_cast<double>(Species),
+        mapBytes, static_cast<double>(mapBytes) / static_cast<double>(Species),
+        (true == result) ? "" : ", over budget");
+
+    return result;
+}
+
+
+/* ===================================== [definition of global functions] ===================================== */
+
+
+/**
+* \brief RunLookupBenchmark
+*
+* This function measures the lookups and prints the results
+*
+* \param[in] Rounds the number of rounds of the imprint benchmark, the lookups run a hundredth of them
+* \return int 0 if the footprint is within the budget, otherwise 1
+*/
+int RunLookupBenchmark(int Rounds)
+{
+    const int rounds = std::max(1, Rounds / 100);
+    std::vector<int> nameIndices(LOOKUP_BENCHMARK_CONFIGURED + LOOKUP_BENCHMARK_QUERIES);
+    std::map<std::string, BenchmarkCuddleData_t> dinolist;
+    alignas(64) uint64_t filter[LOOKUP_FILTER_WORDS];
+    std::vector<std::wstring> missTags;
+    std::vector<int> missIndices;
+    std::mt19937 random(42u);
+    size_t mapFound = 0u;
+    size_t filterFound = 0u;
+    bool isWithinBudget = true;
+
+    /* the name indices of the game are dense, the configured ones are spread among them */
+    std::iota(nameIndices.begin(), nameIndices.end(), 1);
+    std::shuffle(nameIndices.begin(), nameIndices.end(), random);
+
+    Lookup::ClearFilter(filter);
+
+    for (size_t index = 0u; index < nameIndices.size(); index++)
+    {
+        if (index < LOOKUP_BENCHMARK_CONFIGURED)
+        {
+            const std::wstring tag = GetDinoTag(nameIndices[index]);
+
+            dinolist[std::string(tag.begin(), tag.end())] = { 0.1f, 480.0f, false };
+            Lookup::AddToFilter(filter, nameIndices[index]);
+        }
+        else
+        {
+            missTags.push_back(GetDinoTag(nameIndices[index]));
+            missIndices.push_back(nameIndices[index]);
+        }
+    }
+
+    const double mapMiss = MeasureMapMiss(dinolist, missTags, rounds, &mapFound);
+    const double filterMiss = MeasureFilterMiss(filter, missIndices, rounds, &filterFound);
+
+    std::printf("miss path, %u configured tags, %u queries, rounds: %d\n", LOOKUP_BENCHMARK_CONFIGURED, LOOKUP_BENCHMARK_QUERIES, rounds);
+    std::printf("  map:    %.3f ns per lookup (%zu found)\n", mapMiss, mapFound / static_cast<size_t>(rounds));
+    std::printf("  filter: %.3f ns per lookup (%.1fx, %.2f%% false positives)\n", filterMiss, mapMiss / filterMiss,
+        100.0 * static_cast<double>(filterFound) / (static_cast<double>(rounds) * static_cast<double>(missIndices.size())));
+
+    /* hit path over a large configuration, the name indices of the game are spread over the name table */
+    const uint32_t shift = Lookup::GetTableShift(LOOKUP_BENCHMARK_SPECIES);
+    std::vector<BenchmarkSlot_t> slots(static_cast<size_t>(1ull << (64u - shift)), BenchmarkSlot_t());
+    std::map<std::string, BenchmarkCuddleData_t> species;
+    std::vector<std::wstring> hitTags;
+    std::vector<int> hitIndices;
+    float mapChecksum = 0.0f;
+    float tableChecksum = 0.0f;
+
+    for (uint32_t index = 0u; index < LOOKUP_BENCHMARK_SPECIES; index++)
+    {
+        const int nameIndex = static_cast<int>(1u + (index * 37u));
+        const std::wstring tag = GetDinoTag(nameIndex);
+        BenchmarkSlot_t& slot = slots[Lookup::ProbeTable(slots.data(), shift, nameIndex)];
+
+        species[std::string(tag.begin(), tag.end())] = { 0.1f, 8.0f, false };
+        slot.NameIndex = nameIndex;
+        slot.CuddleIntervalTime = 480.0f;
+        hitTags.push_back(tag);
+        hitIndices.push_back(nameIndex);
+    }
+
+    std::shuffle(hitIndices.begin(), hitIndices.end(), random);
+
+    for (size_t index = 0u; index < hitIndices.size(); index++)
+    {
+        hitTags[index] = GetDinoTag(hitIndices[index]);
+    }
+
+    const double mapHit = MeasureMapHit(species, hitTags, rounds, &mapChecksum);
+    const double tableHit = MeasureTableHit(slots, shift, hitIndices, rounds, &tableChecksum);
+
+    std::printf("hit path, %u configured tags, rounds: %d\n", LOOKUP_BENCHMARK_SPECIES, rounds);
+    std::printf("  map:    %.3f ns per lookup\n", mapHit);
+    std::printf("  table:  %.3f ns per lookup (%.1fx, difference of the results: %g)\n", tableHit, mapHit / tableHit, mapChecksum - tableChecksum);
+
+    std::printf("footprint, budget %u bytes per tag\n", LOOKUP_BENCHMARK_MAX_BYTES_PER_SPECIES);
+
+    for (size_t species = 10u; species <= 100000u; species *= 10u)
+    {
+        isWithinBudget = (true == MeasureFootprint(species)) && (true == isWithinBudget);
+    }
+
+    return (true == isWithinBudget) ? 0 : 1;
+}
+
+
+/* =================================================[end of file]================================================= */
@@ -0,0 +1,143 @@
+/*****************************************************************************************************************
+* Copyright (C) 2019 by Matthias Birnthaler                                                                      *
+*                                                                                                                *
+* This file is part of the Cuddle Plugin for Ark Server API                                                      *
+*                                                                                                                *
+*    This program is free software : you can redistribute it and/or modify                                       *
+*    it under the terms of the GNU General Public License as published by                                        *
+*    the Free Software Foundation, either version 3 of the License, or                                           *
+*    (at your option) any later version.                                                                         *
+*                                                                                                                *
+*    This program is distributed in the hope that it will be useful,                                             *
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of                                              *
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the                                                 *
+*    GNU General Public License for more details.                                                                *
+*                                                                                                                *
+*    You should have received a copy of the GNU General Public License                                           *
+*    along with this program.If not, see <https://www.gnu.org/licenses/>.                                        *
+*                                                                                                                *
+*****************************************************************************************************************/
+
+/**
+* \file LookupTest.cpp
+* \author Matthias Birnthaler Matthias-Birnthaler@outlook.com
+* \date 18 October 2026
+* \brief Unit tests of the lookup kernel
+*/
+
+
+/* ================================================ [includes] ================================================ */
+#include "Lookup.h"
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <vector>
+
+
+/* =============================================== [local data] =============================================== */
+
+/** \brief number of configured name indices */
+static const int LookupTest_Configured = 500;
+
+/** \brief number of name indices behind the configured ones that are probed */
+static const int LookupTest_Probed = 100000;
+
+
+/* ============================================ [type definitions] ============================================ */
+
+/** \brief slot of a species table, the payload is the name index it was inserted for */
+struct TestSlot_t {
+    /** \brief name index of the slot, 0 if the slot is empty */
+    int32_t NameIndex;
+    /** \brief the payload */
+    int32_t Payload;
+};
+
+
+/* ===================================== [definition of global functions] ===================================== */
+
+
+TEST(Lookup, FilterHasNoFalseNegatives)
+{
+    alignas(64) uint64_t filter[LOOKUP_FILTER_WORDS];
+
+    Lookup::ClearFilter(filter);
+
+    for (int nameIndex = 1; nameIndex <= LookupTest_Configured; nameIndex++)
+    {
+        Lookup::AddToFilter(filter, nameIndex * 7);
+    }
+
+    for (int nameIndex = 1; nameIndex <= LookupTest_Configured; nameIndex++)
+    {
+        ASSERT_TRUE(Lookup::ProbeFilter(filter, nameIndex * 7)) << "name index " << (nameIndex * 7);
+    }
+}
+
+
+TEST(Lookup, FilterRejectsMostUnconfiguredTags)
+{
+    alignas(64) uint64_t filter[LOOKUP_FILTER_WORDS];
+    int passed = 0;
+
+    Lookup::ClearFilter(filter);
+
+    for (int nameIndex = 1; nameIndex <= LookupTest_Configured; nameIndex++)
+    {
+        Lookup::AddToFilter(filter, nameIndex);
+    }
+
+    for (int nameIndex = LookupTest_Configured + 1; nameIndex <= LookupTest_Configured + LookupTest_Probed; nameIndex++)
+    {
+        passed += (true == Lookup::ProbeFilter(filter, nameIndex)) ? 1 : 0;
+    }
+
+    /* 500 tags set at most 1000 of the 4096 bits, two bits of one block pass in about 6% of the probes */
+    EXPECT_LT(passed, LookupTest_Probed / 10);
+}
+
+
+TEST(Lookup, TableFindsEveryEntry)
+{
+    const uint32_t shift = Lookup::GetTableShift(LookupTest_Configured);
+    std::vector<TestSlot_t> slots(static_cast<size_t>(1ull << (64u - shift)), TestSlot_t());
+
+    ASSERT_GE(slots.size(), 2u * LookupTest_Configured);
+
+    for (int nameIndex = 1; nameIndex <= LookupTest_Configured; nameIndex++)
+    {
+        TestSlot_t& slot = slots[Lookup::ProbeTable(slots.data(), shift, nameIndex * 3)];
+
+        ASSERT_EQ(0, slot.NameIndex);
+        slot = { nameIndex * 3, nameIndex };
+    }
+
+    for (int nameIndex = 1; nameIndex <= LookupTest_Configured; nameIndex++)
+    {
+        const TestSlot_t& slot = slots[Lookup::ProbeTable(slots.data(), shift, nameIndex * 3)];
+
+        ASSERT_EQ(nameIndex * 3, slot.NameIndex);
+        ASSERT_EQ(nameIndex, slot.Payload);
+    }
+
+    for (int nameIndex = 1; nameIndex <= LookupTest_Configured; nameIndex++)
+    {
+        ASSERT_EQ(0, slots[Lookup::ProbeTable(slots.data(), shift, (nameIndex * 3) + 1)].NameIndex);
+    }
+}
+
+
+TEST(Lookup, EmptyFilterRejectsEverything)
+{
+    alignas(64) uint64_t filter[LOOKUP_FILTER_WORDS];
+
+    Lookup::ClearFilter(filter);
+
+    for (int nameIndex = 0; nameIndex < LookupTest_Probed; nameIndex++)
+    {
+        ASSERT_FALSE(Lookup::ProbeFilter(filter, nameIndex));
+    }
+}
+
+
+/* =================================================[end of file]================================================= */